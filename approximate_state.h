@@ -0,0 +1,164 @@
+#ifndef APPROXIMATE_STATE_H
+#define APPROXIMATE_STATE_H
+
+#include "sparse_state.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Approximate State: a sparse state that drops its smallest amplitudes
+// Every prune_interval gates, entries with probability below the current
+// threshold are removed and the rest is renormalized. Each truncation
+// moves the state by the angle asin(√removed) (removed = discarded
+// fraction of the probability mass); gates are unitary and keep angles,
+// so the angle between the exact and the approximate state is at most
+// the sum of these angles, and the fidelity is at least
+//     F ≥ cos²(Σ asin(√removed_k))
+// The error budget is the largest accepted infidelity 1 - F. With a
+// max_nonzeros target, the threshold tunes itself: it rises until the
+// state fits the target and relaxes while the state is well below it.
+// A truncation never discards more than the remaining budget allows, so
+// the state may exceed the target once the budget is spent.
+// 'Form' is SparseState<W> or SortedSparseState<W>.
+template <typename Form>
+class ApproximateState {
+private:
+    Form state;
+    double error_budget;
+    double budget_angle;      // asin(√error_budget)
+    double spent_angle;       // Σ asin(√removed) over all truncations
+    double discarded_mass;    // Σ removed
+    double base_threshold;    // Threshold set by the caller
+    double threshold;         // Current (auto-tuned) probability threshold
+    size_t max_nonzeros;      // Nonzero target, 0 for none
+    int prune_interval;
+    int gates_since_prune;
+    int prune_count;
+    bool budget_limited;      // Last truncation was capped by the budget
+
+public:
+    // Constructor: n qubits in |00...0⟩ with the given infidelity budget
+    // and optional nonzero target
+    ApproximateState(int n, double error_budget, size_t max_nonzeros = 0)
+        : state(n), error_budget(error_budget), spent_angle(0.0), discarded_mass(0.0), base_threshold(0.0),
+          threshold(0.0), max_nonzeros(max_nonzeros), prune_interval(1), gates_since_prune(0),
+          prune_count(0), budget_limited(false) {
+        if (error_budget < 0.0 || error_budget > 1.0) {
+            throw std::invalid_argument("Error budget must be between 0 and 1");
+        }
+        budget_angle = std::asin(std::sqrt(error_budget));
+    }
+
+    // Truncate after every 'interval' applied gates (a composite gate
+    // counts as one)
+    void setPruneInterval(int interval) {
+        if (interval <= 0) {
+            throw std::invalid_argument("Prune interval must be positive");
+        }
+        prune_interval = interval;
+    }
+
+    // Probability below which amplitudes are always dropped (budget
+    // permitting); the auto-tuned threshold never relaxes below it
+    void setThreshold(double probability) {
+        if (probability < 0.0) {
+            throw std::invalid_argument("Threshold must not be negative");
+        }
+        base_threshold = probability;
+        threshold = std::max(threshold, probability);
+    }
+
+    void apply(QuantumGate& gate) {
+        state.apply(gate);
+        if (++gates_since_prune >= prune_interval) {
+            truncate();
+        }
+    }
+
+    // Tune the threshold, drop the entries below it and renormalize
+    // Returns the fraction of the probability mass removed
+    double truncate() {
+        gates_since_prune = 0;
+        std::vector<double> probabilities = state.getProbabilities();
+        double norm = 0.0;
+        for (double p : probabilities) {
+            norm += p;
+        }
+
+        size_t count = probabilities.size();
+        if (max_nonzeros > 0 && count > max_nonzeros) {
+            // Just above the (count - max_nonzeros)-th smallest probability
+            size_t excess = count - max_nonzeros;
+            std::nth_element(probabilities.begin(), probabilities.begin() + (excess - 1), probabilities.end());
+            double needed = std::nextafter(probabilities[excess - 1], std::numeric_limits<double>::infinity());
+            threshold = std::max(threshold, needed);
+        } else if (max_nonzeros > 0 && count < max_nonzeros / 2) {
+            threshold = std::max(base_threshold, threshold / 2);
+        }
+
+        // Lower the threshold until the discarded mass fits the budget
+        std::vector<double> below;
+        for (double p : probabilities) {
+            if (p < threshold) {
+                below.push_back(p);
+            }
+        }
+        std::sort(below.begin(), below.end());
+        double remaining = budget_angle - spent_angle;
+        double cumulative = 0.0;
+        double prune_below = threshold;
+        budget_limited = false;
+        for (double p : below) {
+            if (std::asin(std::sqrt(std::min(1.0, (cumulative + p) / norm))) > remaining) {
+                prune_below = p;
+                budget_limited = true;
+                break;
+            }
+            cumulative += p;
+        }
+        if (cumulative == 0.0) {
+            return 0.0;
+        }
+
+        double removed = state.prune(prune_below) / norm;
+        if (removed > 0.0) {
+            state.scale(1.0 / std::sqrt(norm * (1.0 - removed)));
+            spent_angle += std::asin(std::sqrt(removed));
+            discarded_mass += removed;
+        }
+        prune_count++;
+        return removed;
+    }
+
+    // The underlying sparse state, for amplitude queries
+    const Form& getState() const { return state; }
+
+    size_t getNonzeroCount() const { return state.getNonzeroCount(); }
+
+    // Current probability threshold
+    double getThreshold() const { return threshold; }
+
+    // Total probability mass dropped so far (fractions of the norm at
+    // each truncation)
+    double getDiscardedMass() const { return discarded_mass; }
+
+    // Lower bound on |⟨exact|approximate⟩|², from the truncation angles
+    double getFidelityBound() const {
+        double angle = std::min(spent_angle, M_PI / 2);
+        return std::cos(angle) * std::cos(angle);
+    }
+
+    // Infidelity still available to later truncations
+    double getRemainingBudget() const {
+        return std::max(0.0, error_budget - (1.0 - getFidelityBound()));
+    }
+
+    // True if the last truncation kept entries below the threshold
+    // because the budget ran out
+    bool isBudgetLimited() const { return budget_limited; }
+
+    int getPruneCount() const { return prune_count; }
+};
+
+#endif // APPROXIMATE_STATE_H
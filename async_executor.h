@@ -0,0 +1,354 @@
+#ifndef ASYNC_EXECUTOR_H
+#define ASYNC_EXECUTOR_H
+
+#include "quantum_state.h"
+#include "quantum_gates.h"
+#include "circuit.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Asynchronous Executor: pipelined gate execution with futures
+// Owns a state and two worker threads connected by queues:
+// - the lowering thread takes submitted gates and circuits, flattens
+//   nested circuits and fuses neighbouring gates (adjacent phase shifts on
+//   one qubit merge, adjacent H/X/CNOT pairs on the same qubits cancel),
+//   then hands batches to the execution thread
+// - the execution thread applies the lowered gates in order; gate kernels
+//   still parallelize internally with OpenMP
+// submit() returns at once, so the caller keeps building the next gates
+// while earlier ones lower and run. Queries (query(), getProbability(),
+// getAmplitude(), sample()) return futures that are fulfilled once every
+// gate submitted before them has been applied.
+// If a gate throws, later gates are skipped, pending and later futures
+// receive the exception, and wait()/finish() rethrow it.
+class AsyncExecutor {
+public:
+    // Lowered batches are handed on at this size even while more gates wait
+    static const size_t MAX_BATCH_GATES = 64;
+
+private:
+    // One unit of work; 'query' is set for queries, 'gates' otherwise
+    struct Task {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        std::function<void(QuantumState&, std::exception_ptr)> query;
+        long submissions = 1;  // Submitted tasks this one completes
+    };
+
+    // Queue with blocking pop; pop returns false once closed and drained
+    class TaskQueue {
+    private:
+        std::deque<Task> tasks;
+        std::mutex mutex;
+        std::condition_variable ready;
+        bool closed = false;
+
+    public:
+        void push(Task task) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.push_back(std::move(task));
+            }
+            ready.notify_one();
+        }
+
+        bool pop(Task& task) {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this] { return closed || !tasks.empty(); });
+            if (tasks.empty()) {
+                return false;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            return true;
+        }
+
+        bool empty() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return tasks.empty();
+        }
+
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            ready.notify_all();
+        }
+    };
+
+    QuantumState state;
+    TaskQueue submitted;   // Caller → lowering thread
+    TaskQueue lowered;     // Lowering thread → execution thread
+    std::thread lowering_thread;
+    std::thread execution_thread;
+
+    std::mutex progress_mutex;
+    std::condition_variable progress;
+    long tasks_submitted;  // Guarded by progress_mutex
+    long tasks_done;
+    std::exception_ptr error;
+
+    // Written by the worker threads
+    std::atomic<long> gates_submitted;
+    std::atomic<long> gates_lowered;
+    std::atomic<long> gates_executed;
+
+    static void flatten(const std::shared_ptr<QuantumGate>& gate, std::vector<std::shared_ptr<QuantumGate>>& out) {
+        const Circuit* circuit = dynamic_cast<const Circuit*>(gate.get());
+        if (circuit == nullptr) {
+            out.push_back(gate);
+            return;
+        }
+        for (const auto& part : circuit->getGates()) {
+            flatten(part, out);
+        }
+    }
+
+    // Peephole fusion of 'gate' with the last gate of 'plan'
+    // Returns true if the gate was absorbed (merged or cancelled)
+    static bool fuse(std::vector<std::shared_ptr<QuantumGate>>& plan, const std::shared_ptr<QuantumGate>& gate) {
+        if (plan.empty()) {
+            return false;
+        }
+        QuantumGate* last = plan.back().get();
+        auto* phase = dynamic_cast<PhaseShiftGate*>(gate.get());
+        auto* last_phase = dynamic_cast<PhaseShiftGate*>(last);
+        if (phase != nullptr && last_phase != nullptr && phase->getTarget() == last_phase->getTarget()) {
+            plan.back() = std::make_shared<PhaseShiftGate>(phase->getTarget(), last_phase->getPhase() + phase->getPhase());
+            return true;
+        }
+        auto* h = dynamic_cast<HadamardGate*>(gate.get());
+        auto* last_h = dynamic_cast<HadamardGate*>(last);
+        auto* x = dynamic_cast<XGate*>(gate.get());
+        auto* last_x = dynamic_cast<XGate*>(last);
+        auto* cnot = dynamic_cast<CNOTGate*>(gate.get());
+        auto* last_cnot = dynamic_cast<CNOTGate*>(last);
+        if ((h != nullptr && last_h != nullptr && h->getTarget() == last_h->getTarget()) ||
+            (x != nullptr && last_x != nullptr && x->getTarget() == last_x->getTarget()) ||
+            (cnot != nullptr && last_cnot != nullptr && cnot->getControl() == last_cnot->getControl() &&
+             cnot->getTarget() == last_cnot->getTarget())) {
+            plan.pop_back();  // Self-inverse pair
+            return true;
+        }
+        return false;
+    }
+
+    // Lowering stage: fuse consecutive gate tasks into one batch, flushed
+    // whenever the input runs dry, the batch is full or a query needs the
+    // state
+    void lowerLoop() {
+        std::vector<std::shared_ptr<QuantumGate>> plan;
+        long batched_tasks = 0;
+        auto flush = [&]() {
+            if (batched_tasks == 0) {
+                return;
+            }
+            gates_lowered += long(plan.size());
+            Task batch;
+            batch.gates.swap(plan);
+            batch.submissions = batched_tasks;
+            lowered.push(std::move(batch));
+            batched_tasks = 0;
+        };
+
+        Task task;
+        while (submitted.pop(task)) {
+            if (task.query) {
+                flush();
+                lowered.push(std::move(task));
+                continue;
+            }
+            std::vector<std::shared_ptr<QuantumGate>> flat;
+            for (const auto& gate : task.gates) {
+                flatten(gate, flat);
+            }
+            gates_submitted += long(flat.size());
+            for (const auto& gate : flat) {
+                if (!fuse(plan, gate)) {
+                    plan.push_back(gate);
+                }
+            }
+            batched_tasks++;
+            if (submitted.empty() || plan.size() >= MAX_BATCH_GATES) {
+                flush();
+            }
+        }
+        flush();
+        lowered.close();
+    }
+
+    // Execution stage: apply batches, answer queries, in submission order
+    void executeLoop() {
+        Task task;
+        while (lowered.pop(task)) {
+            std::exception_ptr failure;
+            {
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                failure = error;
+            }
+            if (task.query) {
+                task.query(state, failure);
+            } else if (!failure) {
+                try {
+                    for (const auto& gate : task.gates) {
+                        gate->apply(state);
+                        gates_executed++;
+                    }
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                if (failure && !error) {
+                    error = failure;
+                }
+                tasks_done += task.submissions;
+            }
+            progress.notify_all();
+        }
+    }
+
+    void enqueue(Task task) {
+        if (!lowering_thread.joinable()) {
+            throw std::logic_error("Executor has finished");
+        }
+        {
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            tasks_submitted++;
+        }
+        submitted.push(std::move(task));
+    }
+
+    void stop() {
+        if (!lowering_thread.joinable()) {
+            return;
+        }
+        submitted.close();
+        lowering_thread.join();
+        execution_thread.join();
+    }
+
+public:
+    // Constructor: run on 'initial', which the executor takes over
+    explicit AsyncExecutor(QuantumState initial)
+        : state(std::move(initial)), tasks_submitted(0), tasks_done(0),
+          gates_submitted(0), gates_lowered(0), gates_executed(0) {
+        lowering_thread = std::thread(&AsyncExecutor::lowerLoop, this);
+        execution_thread = std::thread(&AsyncExecutor::executeLoop, this);
+    }
+
+    // Waits for the queued work; errors are dropped (call wait() to see them)
+    ~AsyncExecutor() {
+        stop();
+    }
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    // Queue a gate or a whole circuit; returns immediately
+    void submit(std::shared_ptr<QuantumGate> gate) {
+        if (!gate) {
+            throw std::invalid_argument("Cannot submit a null gate");
+        }
+        Task task;
+        task.gates.push_back(std::move(gate));
+        enqueue(std::move(task));
+    }
+
+    void submit(const Circuit& circuit) {
+        Task task;
+        task.gates = circuit.getGates();
+        enqueue(std::move(task));
+    }
+
+    // Construct and queue a gate: executor.submit<HadamardGate>(0)
+    template <typename Gate, typename... Args>
+    void submit(Args&&... args) {
+        submit(std::make_shared<Gate>(std::forward<Args>(args)...));
+    }
+
+    // Evaluate f(state) after every gate submitted so far
+    template <typename F>
+    auto query(F f) -> std::future<decltype(f(std::declval<const QuantumState&>()))> {
+        typedef decltype(f(std::declval<const QuantumState&>())) Result;
+        auto promise = std::make_shared<std::promise<Result>>();
+        std::future<Result> future = promise->get_future();
+        Task task;
+        task.query = [promise, f](QuantumState& current, std::exception_ptr failure) {
+            if (failure) {
+                promise->set_exception(failure);
+                return;
+            }
+            try {
+                promise->set_value(f(static_cast<const QuantumState&>(current)));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+        enqueue(std::move(task));
+        return future;
+    }
+
+    std::future<double> getProbability(int index) {
+        return query([index](const QuantumState& current) { return current.getProbability(index); });
+    }
+
+    std::future<Complex> getAmplitude(int index) {
+        return query([index](const QuantumState& current) { return current.getAmplitude(index); });
+    }
+
+    // Basis state drawn from the measurement distribution by a uniform
+    // number in [0, 1); the state is not collapsed
+    std::future<int> sample(double uniform) {
+        if (uniform < 0.0 || uniform >= 1.0) {
+            throw std::invalid_argument("Sample point must be in [0, 1)");
+        }
+        return query([uniform](const QuantumState& current) {
+            double cumulative = 0.0;
+            const Complex* amplitudes = current.data();
+            for (int i = 0; i < current.getStateSize(); i++) {
+                cumulative += std::norm(amplitudes[i]);
+                if (uniform < cumulative) {
+                    return i;
+                }
+            }
+            return current.getStateSize() - 1;  // Rounding: last basis state
+        });
+    }
+
+    // Block until all submitted work is done; rethrows a gate failure
+    void wait() {
+        std::unique_lock<std::mutex> lock(progress_mutex);
+        progress.wait(lock, [this] { return tasks_done == tasks_submitted; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Wait, stop the workers and hand back the final state
+    QuantumState finish() {
+        stop();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(state);
+    }
+
+    // Gates as submitted (circuits flattened), after fusion, and applied;
+    // exact once wait() has returned
+    long getGatesSubmitted() const { return gates_submitted; }
+    long getGatesLowered() const { return gates_lowered; }
+    long getGatesExecuted() const { return gates_executed; }
+};
+
+#endif // ASYNC_EXECUTOR_H
@@ -0,0 +1,106 @@
+#ifndef CIRCUIT_H
+#define CIRCUIT_H
+
+#include "quantum_gates.h"
+#include "state_cache.h"
+#include <memory>
+#include <vector>
+
+// Ordered list of gates that can be applied as one unit
+// Gates are held by shared_ptr so circuits can share gate objects cheaply
+// (e.g. a common prefix used by many circuits in a parameter sweep)
+class Circuit : public QuantumGate {
+private:
+    std::vector<std::shared_ptr<QuantumGate>> gates;
+    int gates_skipped;  // Gates skipped via the prefix cache in the last apply
+
+public:
+    Circuit() : gates_skipped(0) {}
+
+    // Append an existing gate
+    void add(std::shared_ptr<QuantumGate> gate) {
+        if (!gate) {
+            throw std::invalid_argument("Cannot add a null gate to a circuit");
+        }
+        gates.push_back(gate);
+    }
+
+    // Construct a gate in place: circuit.add<HadamardGate>(0)
+    template <typename Gate, typename... Args>
+    void add(Args&&... args) {
+        gates.push_back(std::make_shared<Gate>(std::forward<Args>(args)...));
+    }
+
+    // Append all gates of another circuit
+    void append(const Circuit& other) {
+        gates.insert(gates.end(), other.gates.begin(), other.gates.end());
+    }
+
+    void apply(QuantumState& state) override {
+        for (const auto& gate : gates) {
+            gate->apply(state);
+        }
+    }
+
+    // Apply the circuit, resuming from the longest prefix found in 'cache'
+    // Prefix k is fingerprinted from the initial state and the descriptions
+    // of the first k gates. The state is stored back into the cache at the
+    // end of the cacheable part, and with a positive 'checkpoint_interval'
+    // also every that many gates (each snapshot copies the whole state).
+    // Gates that cannot be described end the cacheable part of the circuit.
+    void apply(QuantumState& state, StatePrefixCache& cache, int checkpoint_interval = 0) {
+        if (checkpoint_interval < 0) {
+            throw std::invalid_argument("Checkpoint interval must not be negative");
+        }
+
+        // keys[k] fingerprints "initial state + first k gates"
+        std::vector<PrefixKey> keys;
+        keys.push_back(fingerprintState(state));
+        for (const auto& gate : gates) {
+            std::string description = gate->describe();
+            if (description.empty()) {
+                break;
+            }
+            description += ';';
+            keys.push_back(keys.back().extend(description.data(), description.size()));
+        }
+        size_t cacheable = keys.size() - 1;
+
+        // Resume from the longest cached prefix
+        size_t start = cache.resumeLongestPrefix(keys, state);
+        gates_skipped = static_cast<int>(start);
+
+        for (size_t k = start; k < gates.size(); k++) {
+            gates[k]->apply(state);
+            size_t done = k + 1;
+            bool checkpoint = checkpoint_interval > 0 && done % checkpoint_interval == 0;
+            if (done <= cacheable && (checkpoint || done == cacheable)) {
+                cache.insert(keys[done], state);
+            }
+        }
+    }
+
+    std::string describe() const override {
+        std::string description = "CIRCUIT[";
+        for (const auto& gate : gates) {
+            std::string part = gate->describe();
+            if (part.empty()) {
+                return "";
+            }
+            description += part + ";";
+        }
+        return description + "]";
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        return gates;
+    }
+
+    size_t size() const { return gates.size(); }
+    bool empty() const { return gates.empty(); }
+    const std::shared_ptr<QuantumGate>& operator[](size_t index) const { return gates.at(index); }
+    const std::vector<std::shared_ptr<QuantumGate>>& getGates() const { return gates; }
+    int getGatesSkipped() const { return gates_skipped; }
+};
+
+#endif // CIRCUIT_H
@@ -0,0 +1,309 @@
+#ifndef CIRCUIT_DSL_H
+#define CIRCUIT_DSL_H
+
+#include "circuit.h"
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Compile-time circuit DSL
+// Gates are empty types whose qubits are template parameters, and
+// composing them with >> builds a Sequence<...> type:
+//
+//     auto bell = qdsl::H<0>() >> qdsl::CNOT<0, 1>();
+//     bell.apply(state);
+//
+// When a Sequence is applied, its gate list is split at compile time into
+// fused sweeps: each maximal run of classical permutation gates (X, CNOT,
+// SWAP, Toffoli) becomes one gather pass whose index map is the composed,
+// fully inlined bit arithmetic of the run; each run of phase gates becomes
+// one diagonal pass; Hadamards get a sweep with a constant stride. The same
+// types can also produce a runtime Circuit for tooling via toCircuit().
+namespace qdsl {
+
+enum GateKind { KIND_HADAMARD, KIND_PERMUTATION, KIND_DIAGONAL };
+
+// ----------------------------------------
+// Gate types
+// ----------------------------------------
+
+// Hadamard on qubit Q
+template <int Q>
+struct H {
+    static_assert(Q >= 0, "Qubit must be non-negative");
+    static constexpr GateKind kind = KIND_HADAMARD;
+    static constexpr int max_qubit = Q;
+
+    static void sweep(Complex* amplitudes, uint64_t size) {
+        const double INV_SQRT2 = 0.70710678118654752440;
+        constexpr uint64_t half = 1ULL << Q;
+        for (uint64_t high = 0; high < size; high += 2 * half) {
+            for (uint64_t i = high; i < high + half; i++) {
+                Complex amp0 = amplitudes[i];
+                Complex amp1 = amplitudes[i + half];
+                amplitudes[i] = (amp0 + amp1) * INV_SQRT2;
+                amplitudes[i + half] = (amp0 - amp1) * INV_SQRT2;
+            }
+        }
+    }
+
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<HadamardGate>(Q); }
+};
+
+// Pauli-X on qubit Q
+template <int Q>
+struct X {
+    static_assert(Q >= 0, "Qubit must be non-negative");
+    static constexpr GateKind kind = KIND_PERMUTATION;
+    static constexpr int max_qubit = Q;
+
+    static constexpr uint64_t map(uint64_t x) { return x ^ (1ULL << Q); }
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<XGate>(Q); }
+};
+
+// CNOT with control C and target T
+template <int C, int T>
+struct CNOT {
+    static_assert(C >= 0 && T >= 0, "Qubits must be non-negative");
+    static_assert(C != T, "Control and target qubits must be different");
+    static constexpr GateKind kind = KIND_PERMUTATION;
+    static constexpr int max_qubit = C > T ? C : T;
+
+    static constexpr uint64_t map(uint64_t x) { return x ^ (((x >> C) & 1ULL) << T); }
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<CNOTGate>(C, T); }
+};
+
+// SWAP of qubits A and B
+template <int A, int B>
+struct SWAP {
+    static_assert(A >= 0 && B >= 0, "Qubits must be non-negative");
+    static_assert(A != B, "SWAP qubits must be different");
+    static constexpr GateKind kind = KIND_PERMUTATION;
+    static constexpr int max_qubit = A > B ? A : B;
+
+    static constexpr uint64_t map(uint64_t x) {
+        return x ^ ((((x >> A) ^ (x >> B)) & 1ULL) * ((1ULL << A) | (1ULL << B)));
+    }
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<SWAPGate>(A, B); }
+};
+
+// Toffoli with controls C1, C2 and target T
+template <int C1, int C2, int T>
+struct Toffoli {
+    static_assert(C1 >= 0 && C2 >= 0 && T >= 0, "Qubits must be non-negative");
+    static_assert(C1 != T && C2 != T, "Target qubit must be different from control qubits");
+    static_assert(C1 != C2, "Control qubits must be different");
+    static constexpr GateKind kind = KIND_PERMUTATION;
+    static constexpr int max_qubit = (C1 > C2 ? C1 : C2) > T ? (C1 > C2 ? C1 : C2) : T;
+
+    static constexpr uint64_t map(uint64_t x) { return x ^ (((x >> C1) & (x >> C2) & 1ULL) << T); }
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<ToffoliGate>(C1, C2, T); }
+};
+
+// Phase shift by angle Num·π/Den on qubit Q
+template <int Q, int Num, int Den = 1>
+struct Phase {
+    static_assert(Q >= 0, "Qubit must be non-negative");
+    static_assert(Den != 0, "Phase denominator must be non-zero");
+    static constexpr GateKind kind = KIND_DIAGONAL;
+    static constexpr int max_qubit = Q;
+    static constexpr int qubit = Q;
+
+    static double angle() { return M_PI * Num / Den; }
+    static const Complex& factor() {
+        static const Complex value(std::cos(angle()), std::sin(angle()));
+        return value;
+    }
+    static std::shared_ptr<QuantumGate> makeGate() { return std::make_shared<PhaseShiftGate>(Q, angle()); }
+};
+
+template <int Q> using Z = Phase<Q, 1, 1>;
+template <int Q> using S = Phase<Q, 1, 2>;
+template <int Q> using T = Phase<Q, 1, 4>;
+
+// ----------------------------------------
+// Sequences
+// ----------------------------------------
+
+template <typename Type> struct IsGate : std::false_type {};
+template <int Q> struct IsGate<H<Q>> : std::true_type {};
+template <int Q> struct IsGate<X<Q>> : std::true_type {};
+template <int C, int T> struct IsGate<CNOT<C, T>> : std::true_type {};
+template <int A, int B> struct IsGate<SWAP<A, B>> : std::true_type {};
+template <int C1, int C2, int T> struct IsGate<Toffoli<C1, C2, T>> : std::true_type {};
+template <int Q, int N, int D> struct IsGate<Phase<Q, N, D>> : std::true_type {};
+
+template <typename... Gates>
+struct Sequence {
+    static constexpr size_t length = sizeof...(Gates);
+    typedef std::tuple<Gates...> GateTuple;
+
+private:
+    template <size_t I>
+    using GateAt = typename std::tuple_element<I, GateTuple>::type;
+
+    static constexpr GateKind kindAt(size_t index) {
+        constexpr GateKind kinds[] = {Gates::kind..., KIND_HADAMARD};
+        return kinds[index];
+    }
+
+    // End (exclusive) of the fused run starting at 'begin'
+    static constexpr size_t runEnd(size_t begin) {
+        if (kindAt(begin) == KIND_HADAMARD) {
+            return begin + 1;
+        }
+        size_t end = begin + 1;
+        while (end < length && kindAt(end) == kindAt(begin)) {
+            end++;
+        }
+        return end;
+    }
+
+    // Composed index map of gates [Begin, Begin + sizeof...(Is))
+    template <size_t Begin, size_t... Is>
+    static uint64_t composedMap(uint64_t x, std::index_sequence<Is...>) {
+        ((x = GateAt<Begin + Is>::map(x)), ...);
+        return x;
+    }
+
+    template <size_t Begin, size_t... Is>
+    static Complex diagonalFactor(uint64_t index, std::index_sequence<Is...>) {
+        Complex factor(1.0, 0.0);
+        ((factor = ((index >> GateAt<Begin + Is>::qubit) & 1ULL)
+                       ? complexMul(factor, GateAt<Begin + Is>::factor()) : factor), ...);
+        return factor;
+    }
+
+    template <size_t Begin, size_t End>
+    static void applyRun(Complex* amplitudes, uint64_t size, std::vector<Complex>& scratch) {
+        if constexpr (kindAt(Begin) == KIND_HADAMARD) {
+            GateAt<Begin>::sweep(amplitudes, size);
+        } else if constexpr (kindAt(Begin) == KIND_PERMUTATION) {
+            // One gather pass for the whole run
+            scratch.assign(amplitudes, amplitudes + size);
+            for (uint64_t i = 0; i < size; i++) {
+                amplitudes[composedMap<Begin>(i, std::make_index_sequence<End - Begin>())] = scratch[i];
+            }
+        } else {
+            // One diagonal pass for the whole run
+            for (uint64_t i = 0; i < size; i++) {
+                amplitudes[i] = complexMul(amplitudes[i], diagonalFactor<Begin>(i, std::make_index_sequence<End - Begin>()));
+            }
+        }
+    }
+
+    template <size_t Begin>
+    static void applyFrom(Complex* amplitudes, uint64_t size, std::vector<Complex>& scratch) {
+        if constexpr (Begin < length) {
+            constexpr size_t end = runEnd(Begin);
+            applyRun<Begin, end>(amplitudes, size, scratch);
+            applyFrom<end>(amplitudes, size, scratch);
+        }
+    }
+
+    static constexpr int maxQubit() {
+        int result = -1;
+        for (int q : {Gates::max_qubit..., -1}) {
+            result = q > result ? q : result;
+        }
+        return result;
+    }
+
+public:
+    // Number of fused sweeps the sequence compiles to
+    static constexpr size_t sweepCount() {
+        size_t count = 0;
+        for (size_t begin = 0; begin < length; begin = runEnd(begin)) {
+            count++;
+        }
+        return count;
+    }
+
+    static void apply(QuantumState& state) {
+        if (maxQubit() >= state.getNumQubits()) {
+            throw std::invalid_argument("Qubit exceeds number of qubits in state");
+        }
+        std::vector<Complex> scratch;
+        applyFrom<0>(state.data(), static_cast<uint64_t>(state.getStateSize()), scratch);
+    }
+
+    // Equivalent runtime circuit (one runtime gate per DSL gate)
+    static Circuit toCircuit() {
+        Circuit circuit;
+        (circuit.add(Gates::makeGate()), ...);
+        return circuit;
+    }
+};
+
+// Concatenate sequences at the type level
+template <typename... Sequences> struct Concat;
+template <> struct Concat<> { typedef Sequence<> type; };
+template <typename... Gates> struct Concat<Sequence<Gates...>> { typedef Sequence<Gates...> type; };
+template <typename... G1, typename... G2, typename... Rest>
+struct Concat<Sequence<G1...>, Sequence<G2...>, Rest...> {
+    typedef typename Concat<Sequence<G1..., G2...>, Rest...>::type type;
+};
+
+// Lift a single gate to a sequence; sequences are unchanged
+template <typename Type> struct AsSequence { typedef Sequence<Type> type; };
+template <typename... Gates> struct AsSequence<Sequence<Gates...>> { typedef Sequence<Gates...> type; };
+
+template <typename Type> struct IsDsl : IsGate<Type> {};
+template <typename... Gates> struct IsDsl<Sequence<Gates...>> : std::true_type {};
+
+// Composition: gate/sequence >> gate/sequence
+template <typename L, typename R,
+          typename = typename std::enable_if<IsDsl<L>::value && IsDsl<R>::value>::type>
+constexpr typename Concat<typename AsSequence<L>::type, typename AsSequence<R>::type>::type
+operator>>(L, R) {
+    return {};
+}
+
+// ----------------------------------------
+// Arithmetic blocks (same gate order as quantum_arithmetic.h)
+// ----------------------------------------
+
+// One bit of QuantumAdder: carry_out ^= MAJ(a, b, carry_in), b ^= a ^ carry_in
+template <int A, int B, int Cin, int Cout>
+using AdderBit = Sequence<Toffoli<A, B, Cout>, Toffoli<A, Cin, Cout>, Toffoli<B, Cin, Cout>,
+                          CNOT<A, B>, CNOT<Cin, B>>;
+
+template <int AStart, int BStart, int CarryStart, typename Bits> struct AdderImpl;
+template <int AStart, int BStart, int CarryStart, size_t... Is>
+struct AdderImpl<AStart, BStart, CarryStart, std::index_sequence<Is...>> {
+    typedef typename Concat<AdderBit<AStart + int(Is), BStart + int(Is), CarryStart + int(Is),
+                                     CarryStart + int(Is) + 1>...>::type type;
+};
+
+// Compile-time QuantumAdder: a pure permutation, so it fuses into one pass
+template <int AStart, int BStart, int CarryStart, int NumBits>
+using Adder = typename AdderImpl<AStart, BStart, CarryStart, std::make_index_sequence<NumBits>>::type;
+
+// One bit of QuantumComparator
+template <int A, int B, int R>
+using ComparatorBit = Sequence<CNOT<A, B>, X<B>, Toffoli<B, R - 1, R>>;
+
+template <int AStart, int BStart, int ResultStart, typename Bits> struct ComparatorImpl;
+template <int AStart, int BStart, int ResultStart, size_t... Is>
+struct ComparatorImpl<AStart, BStart, ResultStart, std::index_sequence<Is...>> {
+    typedef typename Concat<Sequence<X<ResultStart>>,
+                            ComparatorBit<AStart + int(Is), BStart + int(Is),
+                                          ResultStart + 1 + int(Is)>...>::type type;
+};
+
+// Compile-time QuantumComparator
+template <int AStart, int BStart, int ResultStart, int NumBits>
+using Comparator = typename ComparatorImpl<AStart, BStart, ResultStart,
+                                           std::make_index_sequence<NumBits>>::type;
+
+} // namespace qdsl
+
+#endif // CIRCUIT_DSL_H
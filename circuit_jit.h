@@ -0,0 +1,466 @@
+#ifndef CIRCUIT_JIT_H
+#define CIRCUIT_JIT_H
+
+#include "circuit.h"
+#include "state_cache.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#define QJIT_SUPPORTED 1
+#else
+#define QJIT_SUPPORTED 0
+#endif
+
+// Just-in-time compiled circuit
+// The circuit is flattened into primitive gates and translated into a C++
+// kernel with every qubit mask, phase factor and modular constant baked in.
+// Runs of classical permutation gates (X, CNOT, SWAP, Toffoli, controlled
+// modular multiplication) are fused into a single gather pass and runs of
+// phase gates into a single diagonal pass. The kernel is compiled with the
+// system compiler into a shared object, cached on disk under the hash of its
+// source, and loaded with dlopen. If the circuit contains a gate the code
+// generator does not know, or no compiler is available, apply() falls back
+// to interpreting the circuit.
+//
+// Loading a library runs its code, so the cache is only used when the
+// directory and the files in it belong to the current user and are not
+// writable by group or others, and a cached library is only loaded if the
+// source saved next to it equals the generated source byte for byte (a
+// hash collision or a stale entry falls back to the interpreter). The
+// compiler runs through posix_spawnp, without a shell.
+//
+// Environment:
+//   QJIT_CXX        compiler command (default "c++")
+//   QJIT_CXXFLAGS   extra flags (default "-O3 -march=native")
+//   QJIT_CACHE_DIR  cache directory (default $XDG_CACHE_HOME/qjit or
+//                   $HOME/.cache/qjit, created with mode 0700)
+// QJIT_CXX and QJIT_CXXFLAGS are split into arguments at whitespace.
+class CircuitJit : public QuantumGate {
+private:
+    typedef void (*KernelFunction)(void* amplitudes, void* scratch, uint64_t size);
+
+    struct Kernel {
+        KernelFunction function;
+        void* library;
+        bool needs_scratch;
+    };
+
+    Circuit circuit;
+    std::string cache_directory;
+    std::map<int, Kernel> kernels;   // Compiled kernels by qubit count
+    std::map<int, bool> failed;      // Qubit counts that could not be compiled
+    std::vector<Complex> scratch;
+    std::string last_error;
+
+    // Kinds of fused segments in the generated kernel
+    enum SegmentKind { SEGMENT_HADAMARD, SEGMENT_PERMUTATION, SEGMENT_DIAGONAL };
+
+    struct Segment {
+        SegmentKind kind;
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+    };
+
+    static std::string envOr(const char* name, const std::string& fallback) {
+        const char* value = std::getenv(name);
+        return (value != nullptr && value[0] != '\0') ? std::string(value) : fallback;
+    }
+
+    // Per-user default: $XDG_CACHE_HOME/qjit, else $HOME/.cache/qjit
+    static std::string defaultCacheDirectory() {
+        std::string explicit_directory = envOr("QJIT_CACHE_DIR", "");
+        if (!explicit_directory.empty()) {
+            return explicit_directory;
+        }
+        std::string xdg = envOr("XDG_CACHE_HOME", "");
+        if (!xdg.empty()) {
+            return xdg + "/qjit";
+        }
+        std::string home = envOr("HOME", "");
+        return home.empty() ? "" : home + "/.cache/qjit";
+    }
+
+#if QJIT_SUPPORTED
+    // True if 'path' is owned by the current user, not writable by group
+    // or others, and of the given type (S_IFDIR or S_IFREG); symbolic
+    // links are not followed
+    static bool isPrivate(const std::string& path, mode_t type) {
+        struct stat info;
+        return lstat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == type &&
+               info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+    }
+
+    // Create the directory and missing parents with mode 0700
+    static void makeDirectories(const std::string& path) {
+        for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+            mkdir(path.substr(0, slash).c_str(), 0700);  // May already exist
+        }
+        mkdir(path.c_str(), 0700);
+    }
+
+    static bool readFile(const std::string& path, std::string& contents) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+        return true;
+    }
+
+    // Run the compiler without a shell, output discarded; true on success
+    static bool runCompiler(const std::string& compiler, const std::string& flags,
+                            const std::string& output, const std::string& input) {
+        std::vector<std::string> arguments;
+        std::istringstream words(compiler + " " + flags);
+        std::string word;
+        while (words >> word) {
+            arguments.push_back(word);
+        }
+        for (const char* extra : {"-std=c++17", "-shared", "-fPIC", "-o"}) {
+            arguments.push_back(extra);
+        }
+        arguments.push_back(output);
+        arguments.push_back(input);
+        std::vector<char*> argv;
+        for (std::string& argument : arguments) {
+            argv.push_back(&argument[0]);
+        }
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        pid_t child;
+        int spawned = posix_spawnp(&child, argv[0], &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        if (spawned != 0) {
+            return false;
+        }
+        int status = 0;
+        while (waitpid(child, &status, 0) < 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#endif
+
+    static std::string number(double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        return text;
+    }
+
+    static std::string mask(int qubit) {
+        return "(1ULL << " + std::to_string(qubit) + ")";
+    }
+
+    // Expand composite gates into primitive ones
+    static void flatten(const std::shared_ptr<QuantumGate>& gate,
+                        std::vector<std::shared_ptr<QuantumGate>>& out) {
+        std::vector<std::shared_ptr<QuantumGate>> parts = gate->decompose();
+        if (parts.empty()) {
+            out.push_back(gate);
+            return;
+        }
+        for (const auto& part : parts) {
+            flatten(part, out);
+        }
+    }
+
+    // Classify a primitive gate; false if the generator cannot handle it
+    static bool classify(const QuantumGate* gate, int num_qubits, SegmentKind& kind) {
+        if (auto h = dynamic_cast<const HadamardGate*>(gate)) {
+            kind = SEGMENT_HADAMARD;
+            return h->getTarget() < num_qubits;
+        }
+        if (auto p = dynamic_cast<const PhaseShiftGate*>(gate)) {
+            kind = SEGMENT_DIAGONAL;
+            return p->getTarget() < num_qubits;
+        }
+        kind = SEGMENT_PERMUTATION;
+        if (auto x = dynamic_cast<const XGate*>(gate)) {
+            return x->getTarget() < num_qubits;
+        }
+        if (auto c = dynamic_cast<const CNOTGate*>(gate)) {
+            return c->getControl() < num_qubits && c->getTarget() < num_qubits;
+        }
+        if (auto w = dynamic_cast<const SWAPGate*>(gate)) {
+            return w->getQubit1() < num_qubits && w->getQubit2() < num_qubits;
+        }
+        if (auto t = dynamic_cast<const ToffoliGate*>(gate)) {
+            return t->getControl1() < num_qubits && t->getControl2() < num_qubits &&
+                   t->getTarget() < num_qubits;
+        }
+        if (auto m = dynamic_cast<const ControlledModMultGate*>(gate)) {
+            return m->getControl() < num_qubits &&
+                   m->getTargetStart() + m->getTargetCount() <= num_qubits &&
+                   m->getTargetCount() < 32 && m->getModulus() < (1ULL << 32) &&
+                   m->getMultiplier() < (1ULL << 32);
+        }
+        return false;
+    }
+
+    // Index update of one permutation gate, applied to variable 'x'
+    static std::string emitPermutationStep(const QuantumGate* gate) {
+        if (auto g = dynamic_cast<const XGate*>(gate)) {
+            return "        x ^= " + mask(g->getTarget()) + ";\n";
+        }
+        if (auto g = dynamic_cast<const CNOTGate*>(gate)) {
+            return "        x ^= ((x >> " + std::to_string(g->getControl()) + ") & 1ULL) << "
+                   + std::to_string(g->getTarget()) + ";\n";
+        }
+        if (auto g = dynamic_cast<const SWAPGate*>(gate)) {
+            std::string q1 = std::to_string(g->getQubit1());
+            std::string q2 = std::to_string(g->getQubit2());
+            return "        { uint64_t d = ((x >> " + q1 + ") ^ (x >> " + q2 + ")) & 1ULL;"
+                   " x ^= (d << " + q1 + ") | (d << " + q2 + "); }\n";
+        }
+        if (auto g = dynamic_cast<const ToffoliGate*>(gate)) {
+            return "        x ^= ((x >> " + std::to_string(g->getControl1()) + ") & (x >> "
+                   + std::to_string(g->getControl2()) + ") & 1ULL) << "
+                   + std::to_string(g->getTarget()) + ";\n";
+        }
+        auto g = dynamic_cast<const ControlledModMultGate*>(gate);
+        std::string start = std::to_string(g->getTargetStart());
+        std::string field = std::to_string((1ULL << g->getTargetCount()) - 1) + "ULL";
+        return "        if ((x >> " + std::to_string(g->getControl()) + ") & 1ULL) {\n"
+               "            uint64_t y = (x >> " + start + ") & " + field + ";\n"
+               "            if (y < " + std::to_string(g->getModulus()) + "ULL) {\n"
+               "                y = (y * " + std::to_string(g->getMultiplier()) + "ULL) % "
+               + std::to_string(g->getModulus()) + "ULL;\n"
+               "                x = (x & ~(" + field + " << " + start + ")) | (y << " + start + ");\n"
+               "            }\n"
+               "        }\n";
+    }
+
+    static std::string emitSegment(const Segment& segment) {
+        std::string code;
+        if (segment.kind == SEGMENT_HADAMARD) {
+            auto h = static_cast<const HadamardGate*>(segment.gates[0].get());
+            std::string half = mask(h->getTarget());
+            code += "    // H(" + std::to_string(h->getTarget()) + ")\n";
+            code += "    for (uint64_t high = 0; high < size; high += 2 * " + half + ") {\n";
+            code += "        for (uint64_t i = high; i < high + " + half + "; i++) {\n";
+            code += "            C a0 = a[i], a1 = a[i + " + half + "];\n";
+            code += "            a[i] = (a0 + a1) * INV_SQRT2;\n";
+            code += "            a[i + " + half + "] = (a0 - a1) * INV_SQRT2;\n";
+            code += "        }\n    }\n";
+        } else if (segment.kind == SEGMENT_PERMUTATION) {
+            code += "    // Fused permutation of " + std::to_string(segment.gates.size()) + " gates\n";
+            code += "    std::memcpy(static_cast<void*>(s), a, size * sizeof(C));\n";
+            code += "    for (uint64_t i = 0; i < size; i++) {\n";
+            code += "        uint64_t x = i;\n";
+            for (const auto& gate : segment.gates) {
+                code += emitPermutationStep(gate.get());
+            }
+            code += "        a[x] = s[i];\n    }\n";
+        } else {
+            code += "    // Fused diagonal of " + std::to_string(segment.gates.size()) + " phase gates\n";
+            code += "    for (uint64_t i = 0; i < size; i++) {\n";
+            code += "        C f(1.0, 0.0);\n";
+            for (const auto& gate : segment.gates) {
+                auto p = static_cast<const PhaseShiftGate*>(gate.get());
+                code += "        if (i & " + mask(p->getTarget()) + ") f = mul(f, C("
+                        + number(std::cos(p->getPhase())) + ", " + number(std::sin(p->getPhase())) + "));\n";
+            }
+            code += "        a[i] = mul(a[i], f);\n    }\n";
+        }
+        return code;
+    }
+
+    // Generate kernel source; false if the circuit is not supported
+    bool generate(int num_qubits, std::string& source, bool& needs_scratch) const {
+        std::vector<std::shared_ptr<QuantumGate>> flat;
+        flatten(std::make_shared<Circuit>(circuit), flat);
+
+        std::vector<Segment> segments;
+        for (const auto& gate : flat) {
+            SegmentKind kind;
+            if (!classify(gate.get(), num_qubits, kind)) {
+                return false;
+            }
+            if (kind != SEGMENT_HADAMARD && !segments.empty() && segments.back().kind == kind) {
+                segments.back().gates.push_back(gate);
+            } else {
+                segments.push_back(Segment{kind, {gate}});
+            }
+        }
+
+        needs_scratch = false;
+        source = "// Generated by CircuitJit for " + std::to_string(num_qubits) + " qubits\n"
+                 "#include <complex>\n#include <cstdint>\n#include <cstring>\n"
+                 "typedef std::complex<double> C;\n"
+                 "// Product without the __muldc3 call of std::complex (see complex_math.h)\n"
+                 "static inline C mul(C x, C y) {\n"
+                 "    return C(x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real());\n"
+                 "}\n"
+                 "static const double INV_SQRT2 = 0.70710678118654752440;\n"
+                 "extern \"C\" void qjit_run(void* amplitudes, void* scratch, uint64_t size) {\n"
+                 "    C* a = static_cast<C*>(amplitudes);\n"
+                 "    C* s = static_cast<C*>(scratch);\n"
+                 "    (void)s;\n";
+        for (const Segment& segment : segments) {
+            needs_scratch = needs_scratch || segment.kind == SEGMENT_PERMUTATION;
+            source += emitSegment(segment);
+        }
+        source += "}\n";
+        return true;
+    }
+
+    // Compile (or load from the disk cache) the kernel for 'num_qubits'
+    bool build(int num_qubits) {
+#if QJIT_SUPPORTED
+        std::string source;
+        bool needs_scratch = false;
+        if (!generate(num_qubits, source, needs_scratch)) {
+            last_error = "circuit contains gates the JIT cannot translate";
+            return false;
+        }
+
+        std::string compiler = envOr("QJIT_CXX", "c++");
+        std::string flags = envOr("QJIT_CXXFLAGS", "-O3 -march=native");
+        std::string key_text = compiler + "\n" + flags + "\n" + source;
+        char name[32];
+        std::snprintf(name, sizeof(name), "qjit_%016llx",
+                      static_cast<unsigned long long>(fnv1a(key_text.data(), key_text.size())));
+        if (cache_directory.empty()) {
+            last_error = "no JIT cache directory (set QJIT_CACHE_DIR or HOME)";
+            return false;
+        }
+        makeDirectories(cache_directory);
+        if (!isPrivate(cache_directory, S_IFDIR)) {
+            last_error = "JIT cache directory " + cache_directory +
+                         " must be a directory owned by this user and not writable by others";
+            return false;
+        }
+        std::string base = cache_directory + "/" + name;
+        std::string source_path = base + ".cpp";
+        std::string library_path = base + ".so";
+
+        if (access(library_path.c_str(), F_OK) != 0) {
+            // Write the source and compile to temporary names, then rename
+            // so concurrent users never see half-written files
+            std::string temporary = base + "." + std::to_string(getpid());
+            std::ofstream file(temporary + ".tmp.cpp", std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                last_error = "cannot write to JIT cache directory " + cache_directory;
+                return false;
+            }
+            file << source;
+            file.close();
+            bool compiled = runCompiler(compiler, flags, temporary + ".tmp.so", temporary + ".tmp.cpp");
+            if (!compiled || std::rename((temporary + ".tmp.cpp").c_str(), source_path.c_str()) != 0 ||
+                std::rename((temporary + ".tmp.so").c_str(), library_path.c_str()) != 0) {
+                std::remove((temporary + ".tmp.cpp").c_str());
+                std::remove((temporary + ".tmp.so").c_str());
+                last_error = "compiler '" + compiler + "' failed or is not available";
+                return false;
+            }
+        }
+
+        // Only load a library we could have written, built from this source
+        std::string saved_source;
+        if (!isPrivate(library_path, S_IFREG) || !isPrivate(source_path, S_IFREG) ||
+            !readFile(source_path, saved_source)) {
+            last_error = "cached kernel " + library_path + " is not a private file of this user";
+            return false;
+        }
+        if (saved_source != source) {
+            last_error = "cached kernel " + library_path + " was built from different source";
+            return false;
+        }
+
+        void* library = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (library == nullptr) {
+            last_error = std::string("dlopen failed: ") + dlerror();
+            return false;
+        }
+        void* symbol = dlsym(library, "qjit_run");
+        if (symbol == nullptr) {
+            dlclose(library);
+            last_error = "kernel symbol missing in " + library_path;
+            return false;
+        }
+        kernels[num_qubits] = Kernel{reinterpret_cast<KernelFunction>(symbol), library, needs_scratch};
+        return true;
+#else
+        (void)num_qubits;
+        last_error = "runtime compilation is not supported on this platform";
+        return false;
+#endif
+    }
+
+public:
+    explicit CircuitJit(const Circuit& source_circuit,
+                        const std::string& cache_dir = defaultCacheDirectory())
+        : circuit(source_circuit), cache_directory(cache_dir) {}
+
+    CircuitJit(const CircuitJit&) = delete;
+    CircuitJit& operator=(const CircuitJit&) = delete;
+
+    ~CircuitJit() override {
+#if QJIT_SUPPORTED
+        for (auto& entry : kernels) {
+            dlclose(entry.second.library);
+        }
+#endif
+    }
+
+    // Compile ahead of time for a given state size; returns true on success
+    bool compile(int num_qubits) {
+        if (kernels.count(num_qubits) != 0) {
+            return true;
+        }
+        if (failed.count(num_qubits) != 0) {
+            return false;
+        }
+        if (!build(num_qubits)) {
+            failed[num_qubits] = true;
+            return false;
+        }
+        return true;
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        if (!compile(num_qubits)) {
+            circuit.apply(state);  // Interpreter fallback
+            return;
+        }
+
+        const Kernel& kernel = kernels[num_qubits];
+        uint64_t size = static_cast<uint64_t>(state.getStateSize());
+        if (kernel.needs_scratch && scratch.size() < size) {
+            scratch.resize(size);
+        }
+        kernel.function(state.data(), kernel.needs_scratch ? scratch.data() : nullptr, size);
+    }
+
+    std::string describe() const override { return circuit.describe(); }
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override { return circuit.getGates(); }
+
+    // True if a compiled kernel exists for this qubit count
+    bool isCompiled(int num_qubits) const { return kernels.count(num_qubits) != 0; }
+    const std::string& getLastError() const { return last_error; }
+    const Circuit& getCircuit() const { return circuit; }
+};
+
+#endif // CIRCUIT_JIT_H
@@ -0,0 +1,65 @@
+#ifndef COMPLEX_MATH_H
+#define COMPLEX_MATH_H
+
+#include "quantum_state.h"
+
+// Complex arithmetic for gate kernels and reductions
+// The product of two std::complex<double> follows C99 Annex G: unless the
+// whole build uses -ffast-math or -fcx-limited-range, every product
+// becomes a call to __muldc3, which checks for NaN parts and recovers
+// infinities. That call cannot be inlined or vectorized and puts a branch
+// in every hot loop. Amplitudes are always finite, so kernels use these
+// helpers instead: plain real/imaginary arithmetic on doubles, which the
+// compiler inlines, keeps in registers and vectorizes under the default
+// flags. Results match std::complex for finite operands.
+
+// a · b
+inline Complex complexMul(Complex a, Complex b) {
+    double ar = a.real(), ai = a.imag();
+    double br = b.real(), bi = b.imag();
+    return Complex(ar * br - ai * bi, ar * bi + ai * br);
+}
+
+// conj(a) · b, the term of an inner product ⟨a|b⟩
+inline Complex complexMulConj(Complex a, Complex b) {
+    double ar = a.real(), ai = a.imag();
+    double br = b.real(), bi = b.imag();
+    return Complex(ar * br + ai * bi, ar * bi - ai * br);
+}
+
+// acc + a · b
+inline Complex complexFma(Complex acc, Complex a, Complex b) {
+    double ar = a.real(), ai = a.imag();
+    double br = b.real(), bi = b.imag();
+    return Complex(acc.real() + ar * br - ai * bi, acc.imag() + ar * bi + ai * br);
+}
+
+// a · b in single precision, for float-storage kernels (std::complex<float>
+// products call __mulsc3 the same way)
+inline std::complex<float> complexMul(std::complex<float> a, std::complex<float> b) {
+    float ar = a.real(), ai = a.imag();
+    float br = b.real(), bi = b.imag();
+    return std::complex<float>(ar * br - ai * bi, ar * bi + ai * br);
+}
+
+// |a|², without the scaling std::abs performs
+inline double complexNorm(Complex a) {
+    return a.real() * a.real() + a.imag() * a.imag();
+}
+
+// Multiply a run of amplitudes by one factor in place
+// Works on the interleaved (real, imaginary) doubles, which std::complex
+// guarantees as its layout, so the loop vectorizes without any complex
+// type in its body
+inline void complexScale(Complex* amplitudes, size_t count, Complex factor) {
+    double* values = reinterpret_cast<double*>(amplitudes);
+    double fr = factor.real(), fi = factor.imag();
+    for (size_t k = 0; k < count; k++) {
+        double re = values[2 * k];
+        double im = values[2 * k + 1];
+        values[2 * k] = re * fr - im * fi;
+        values[2 * k + 1] = re * fi + im * fr;
+    }
+}
+
+#endif // COMPLEX_MATH_H
@@ -0,0 +1,419 @@
+#ifndef FACTORIZED_STATE_H
+#define FACTORIZED_STATE_H
+
+#include "quantum_state.h"
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Factorized State: a product state |ψ₁⟩ ⊗ |ψ₂⟩ ⊗ ... kept as separate vectors
+// Every factor owns a set of qubits and a small QuantumState over just
+// those qubits. All qubits start unentangled (one single-qubit factor
+// each). A gate acting within one factor only touches that factor; a gate
+// spanning several factors first merges them by tensor product. Circuits
+// with long product prefixes (e.g. Hadamards on a control register while
+// the target register is still |1⟩) therefore run at the cost of the
+// factors instead of the full 2^n space. Factors are never split again.
+//
+// Within a factor, local bit k is the k-th smallest global qubit of the
+// factor. Keeping the qubits sorted means that a contiguous global qubit
+// range that lies in one factor is also contiguous there, so register
+// gates can be re-targeted by shifting their start qubit.
+class FactorizedState {
+public:
+    struct Factor {
+        std::vector<int> qubits;  // Global qubit indices, ascending
+        QuantumState state;       // Amplitudes over 'qubits'
+    };
+
+private:
+    int num_qubits;
+    std::vector<Factor> factors;
+    std::vector<int> factor_of;  // Factor index of each global qubit
+    int merge_count;
+
+    // Qubits a known gate acts on and how to rebuild it on local qubit
+    // indices; 'local' maps a global qubit to its position in the factor
+    struct GateFootprint {
+        std::vector<int> qubits;
+        std::function<std::shared_ptr<QuantumGate>(const std::function<int(int)>& local)> rebuild;
+    };
+
+    static std::vector<int> range(int start, int count) {
+        std::vector<int> qubits;
+        for (int q = start; q < start + count; q++) {
+            qubits.push_back(q);
+        }
+        return qubits;
+    }
+
+    // Footprint of a gate the factorized state understands; false for any
+    // other gate. Register gates become the same gate on local qubits.
+    static bool footprint(const QuantumGate& gate, GateFootprint& fp) {
+        if (auto g = dynamic_cast<const HadamardGate*>(&gate)) {
+            int t = g->getTarget();
+            fp.qubits = {t};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<HadamardGate>(local(t));
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const XGate*>(&gate)) {
+            int t = g->getTarget();
+            fp.qubits = {t};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<XGate>(local(t));
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const PhaseShiftGate*>(&gate)) {
+            int t = g->getTarget();
+            double phase = g->getPhase();
+            fp.qubits = {t};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<PhaseShiftGate>(local(t), phase);
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const CNOTGate*>(&gate)) {
+            int c = g->getControl();
+            int t = g->getTarget();
+            fp.qubits = {c, t};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<CNOTGate>(local(c), local(t));
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const SWAPGate*>(&gate)) {
+            int q1 = g->getQubit1();
+            int q2 = g->getQubit2();
+            fp.qubits = {q1, q2};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<SWAPGate>(local(q1), local(q2));
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const ToffoliGate*>(&gate)) {
+            int c1 = g->getControl1();
+            int c2 = g->getControl2();
+            int t = g->getTarget();
+            fp.qubits = {c1, c2, t};
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<ToffoliGate>(local(c1), local(c2), local(t));
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const ControlledPhaseShiftGate*>(&gate)) {
+            std::vector<int> controls = g->getControls();
+            int t = g->getTarget();
+            double phase = g->getPhase();
+            fp.qubits = controls;
+            fp.qubits.push_back(t);
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                std::vector<int> local_controls;
+                for (int c : controls) {
+                    local_controls.push_back(local(c));
+                }
+                return std::make_shared<ControlledPhaseShiftGate>(local_controls, local(t), phase);
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const ControlledModMultGate*>(&gate)) {
+            int c = g->getControl();
+            int start = g->getTargetStart();
+            int count = g->getTargetCount();
+            uint64_t multiplier = g->getMultiplier();
+            uint64_t modulus = g->getModulus();
+            fp.qubits = range(start, count);
+            fp.qubits.push_back(c);
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<ControlledModMultGate>(local(c), local(start), count, multiplier, modulus);
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const LookupModMultGate*>(&gate)) {
+            int window_start = g->getWindowStart();
+            int window_size = g->getWindowSize();
+            int start = g->getTargetStart();
+            int count = g->getTargetCount();
+            std::vector<uint64_t> multipliers = g->getMultipliers();
+            uint64_t modulus = g->getModulus();
+            fp.qubits = range(window_start, window_size);
+            std::vector<int> target = range(start, count);
+            fp.qubits.insert(fp.qubits.end(), target.begin(), target.end());
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<LookupModMultGate>(local(window_start), window_size, local(start), count,
+                                                           multipliers, modulus);
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const RegisterSwapGate*>(&gate)) {
+            int a = g->getAStart();
+            int b = g->getBStart();
+            int count = g->getCount();
+            fp.qubits = range(a, count);
+            std::vector<int> other = range(b, count);
+            fp.qubits.insert(fp.qubits.end(), other.begin(), other.end());
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<RegisterSwapGate>(local(a), local(b), count);
+            };
+            return true;
+        }
+        if (auto g = dynamic_cast<const ControlledRegisterSwapGate*>(&gate)) {
+            int c = g->getControl();
+            int a = g->getAStart();
+            int b = g->getBStart();
+            int count = g->getCount();
+            fp.qubits = range(a, count);
+            std::vector<int> other = range(b, count);
+            fp.qubits.insert(fp.qubits.end(), other.begin(), other.end());
+            fp.qubits.push_back(c);
+            fp.rebuild = [=](const std::function<int(int)>& local) {
+                return std::make_shared<ControlledRegisterSwapGate>(local(c), local(a), local(b), count);
+            };
+            return true;
+        }
+        return false;
+    }
+
+    // Tensor product of several factors, with the qubits of the result
+    // sorted. Every merged amplitude is the product of one entry per part;
+    // the entry of part p is found by gathering its bits from the merged
+    // index through two lookup tables (low and high half of the index).
+    // Many parts are folded in pairs, smallest first, so the total work is
+    // about twice the size of the result instead of one product per part.
+    static Factor combine(const std::vector<const Factor*>& parts) {
+        if (parts.size() > 2) {
+            std::vector<const Factor*> order(parts);
+            std::sort(order.begin(), order.end(), [](const Factor* lhs, const Factor* rhs) {
+                return lhs->qubits.size() < rhs->qubits.size();
+            });
+            Factor folded = combine({order[0], order[1]});
+            for (size_t p = 2; p < order.size(); p++) {
+                folded = combine({&folded, order[p]});
+            }
+            return folded;
+        }
+
+        Factor merged{{}, QuantumState(1)};
+        for (const Factor* part : parts) {
+            merged.qubits.insert(merged.qubits.end(), part->qubits.begin(), part->qubits.end());
+        }
+        std::sort(merged.qubits.begin(), merged.qubits.end());
+        if (parts.size() == 1 && parts[0]->qubits == merged.qubits) {
+            merged.state = parts[0]->state;
+            return merged;
+        }
+        int merged_count = int(merged.qubits.size());
+        merged.state = QuantumState(merged_count);
+
+        int low_bits = std::min(merged_count, 16);
+        int low_size = 1 << low_bits;
+        int high_size = 1 << (merged_count - low_bits);
+        int num_parts = int(parts.size());
+        std::vector<int> low_gather(size_t(num_parts) * low_size, 0);
+        std::vector<int> high_gather(size_t(num_parts) * high_size, 0);
+        std::vector<const Complex*> sources(num_parts);
+        for (int p = 0; p < num_parts; p++) {
+            sources[p] = parts[p]->state.data();
+            const std::vector<int>& qubits = parts[p]->qubits;
+            for (size_t k = 0; k < qubits.size(); k++) {
+                int position = int(std::lower_bound(merged.qubits.begin(), merged.qubits.end(), qubits[k]) -
+                                   merged.qubits.begin());
+                if (position < low_bits) {
+                    for (int x = 0; x < low_size; x++) {
+                        low_gather[size_t(p) * low_size + x] |= ((x >> position) & 1) << k;
+                    }
+                } else {
+                    for (int x = 0; x < high_size; x++) {
+                        high_gather[size_t(p) * high_size + x] |= ((x >> (position - low_bits)) & 1) << k;
+                    }
+                }
+            }
+        }
+
+        Complex* out = merged.state.data();
+        int state_size = merged.state.getStateSize();
+        const int* low = low_gather.data();
+        const int* high = high_gather.data();
+        const Complex* const* source = sources.data();
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            int low_index = i & (low_size - 1);
+            int high_index = i >> low_bits;
+            Complex amplitude = source[0][low[low_index] | high[high_index]];
+            for (int p = 1; p < num_parts; p++) {
+                amplitude = complexMul(amplitude, source[p][low[p * low_size + low_index] | high[p * high_size + high_index]]);
+            }
+            out[i] = amplitude;
+        }
+        return merged;
+    }
+
+    // Merge the factors holding 'qubits' into one; returns its index
+    int mergeFactorsOf(const std::vector<int>& qubits) {
+        std::vector<int> indices;
+        for (int q : qubits) {
+            if (q < 0 || q >= num_qubits) {
+                throw std::invalid_argument("Gate qubit out of range for factorized state");
+            }
+            indices.push_back(factor_of[q]);
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        if (indices.size() == 1) {
+            return indices[0];
+        }
+
+        std::vector<const Factor*> parts;
+        for (int index : indices) {
+            parts.push_back(&factors[index]);
+        }
+        Factor merged = combine(parts);
+        merge_count++;
+
+        // Replace the first merged factor, drop the others
+        factors[indices[0]] = std::move(merged);
+        for (size_t k = indices.size(); k-- > 1;) {
+            factors.erase(factors.begin() + indices[k]);
+        }
+        reindex();
+        return factor_of[qubits[0]];
+    }
+
+    void reindex() {
+        for (size_t f = 0; f < factors.size(); f++) {
+            for (int q : factors[f].qubits) {
+                factor_of[q] = int(f);
+            }
+        }
+    }
+
+public:
+    // Constructor: n qubits, all |0⟩, as n single-qubit factors
+    FactorizedState(int n) : num_qubits(n), merge_count(0) {
+        if (n <= 0) {
+            throw std::invalid_argument("Number of qubits must be positive");
+        }
+        for (int q = 0; q < n; q++) {
+            factors.push_back(Factor{{q}, QuantumState(1)});
+            factor_of.push_back(q);
+        }
+    }
+
+    // Apply a gate, merging only the factors it spans
+    // A SWAP between two factors just exchanges the qubit labels. Gates
+    // without a known footprint are expanded through decompose(); any
+    // other gate forces a merge of all factors.
+    void apply(QuantumGate& gate) {
+        GateFootprint fp;
+        if (footprint(gate, fp)) {
+            auto swap = dynamic_cast<const SWAPGate*>(&gate);
+            if (swap != nullptr && factor_of[swap->getQubit1()] != factor_of[swap->getQubit2()]) {
+                relabel(swap->getQubit1(), swap->getQubit2());
+                return;
+            }
+            Factor& factor = factors[mergeFactorsOf(fp.qubits)];
+            const std::vector<int>& qubits = factor.qubits;
+            auto local = [&](int q) {
+                return int(std::lower_bound(qubits.begin(), qubits.end(), q) - qubits.begin());
+            };
+            fp.rebuild(local)->apply(factor.state);
+            return;
+        }
+
+        std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+        if (!parts.empty()) {
+            for (const auto& part : parts) {
+                apply(*part);
+            }
+            return;
+        }
+
+        // Opaque gate: fall back to one dense factor over all qubits
+        Factor& factor = factors[mergeFactorsOf(range(0, num_qubits))];
+        gate.apply(factor.state);
+    }
+
+    // Apply every gate of a sequence in order
+    void apply(const std::vector<std::shared_ptr<QuantumGate>>& gates) {
+        for (const auto& gate : gates) {
+            apply(*gate);
+        }
+    }
+
+    // Exchange two qubits held by different factors without touching
+    // amplitudes beyond re-sorting the two factors
+    void relabel(int q1, int q2) {
+        Factor& a = factors[factor_of[q1]];
+        Factor& b = factors[factor_of[q2]];
+        std::replace(a.qubits.begin(), a.qubits.end(), q1, q2);
+        std::replace(b.qubits.begin(), b.qubits.end(), q2, q1);
+        // Re-sort through a one-part product
+        for (Factor* factor : {&a, &b}) {
+            if (!std::is_sorted(factor->qubits.begin(), factor->qubits.end())) {
+                Factor unsorted{factor->qubits, factor->state};
+                Factor sorted = combine({&unsorted});
+                *factor = std::move(sorted);
+            }
+        }
+        reindex();
+    }
+
+    // Amplitude of a global basis state: product of one entry per factor
+    Complex getAmplitude(int index) const {
+        if (index < 0 || index >= (1 << num_qubits)) {
+            throw std::out_of_range("Index out of range");
+        }
+        Complex amplitude(1, 0);
+        for (const Factor& factor : factors) {
+            int local = 0;
+            for (size_t k = 0; k < factor.qubits.size(); k++) {
+                local |= ((index >> factor.qubits[k]) & 1) << k;
+            }
+            amplitude = complexMul(amplitude, factor.state.data()[local]);
+        }
+        return amplitude;
+    }
+
+    double getProbability(int index) const {
+        return std::norm(getAmplitude(index));
+    }
+
+    // Full state vector (tensor product of all factors)
+    QuantumState toDense() const {
+        std::vector<const Factor*> parts;
+        for (const Factor& factor : factors) {
+            parts.push_back(&factor);
+        }
+        return combine(parts).state;
+    }
+
+    int getNumQubits() const { return num_qubits; }
+    int getFactorCount() const { return int(factors.size()); }
+    int getMergeCount() const { return merge_count; }
+    const std::vector<Factor>& getFactors() const { return factors; }
+
+    // Size of the largest factor in qubits
+    int getLargestFactor() const {
+        size_t largest = 0;
+        for (const Factor& factor : factors) {
+            largest = std::max(largest, factor.qubits.size());
+        }
+        return int(largest);
+    }
+
+    // Memory used by all factors' amplitude arrays in bytes
+    size_t getMemoryUsage() const {
+        size_t bytes = 0;
+        for (const Factor& factor : factors) {
+            bytes += factor.state.getMemoryUsage();
+        }
+        return bytes;
+    }
+};
+
+#endif // FACTORIZED_STATE_H
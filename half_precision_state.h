@@ -0,0 +1,296 @@
+#ifndef HALF_PRECISION_STATE_H
+#define HALF_PRECISION_STATE_H
+
+#include "mixed_precision_state.h"
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+// IEEE binary16: 1 sign, 5 exponent, 10 mantissa bits
+// Conversions use the F16C instructions when the compiler targets them
+// (-mf16c or -march=native on x86) and exact software rounding otherwise;
+// both round to nearest even.
+struct Float16Format {
+    static constexpr double UNIT_ROUNDOFF = 1.0 / 2048;  // 2^-11
+
+    static const char* name() { return "fp16"; }
+
+    static float toFloat(uint16_t h) {
+#ifdef __F16C__
+        return _cvtsh_ss(h);
+#else
+        uint32_t sign = uint32_t(h & 0x8000) << 16;
+        uint32_t exponent = (h >> 10) & 0x1F;
+        uint32_t mantissa = h & 0x3FF;
+        float value;
+        if (exponent == 0) {
+            value = float(mantissa) * (1.0f / 16777216.0f);  // Subnormal: mantissa · 2^-24
+            return sign ? -value : value;
+        }
+        uint32_t bits = exponent == 31 ? (sign | 0x7F800000 | (mantissa << 13))
+                                       : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+#endif
+    }
+
+    static uint16_t fromFloat(float f) {
+#ifdef __F16C__
+        return _cvtss_sh(f, 0);
+#else
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+        uint32_t magnitude = bits & 0x7FFFFFFF;
+        if (magnitude >= 0x7F800000) {
+            return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0);  // Inf, NaN
+        }
+        if (magnitude >= 0x477FF000) {
+            return sign | 0x7C00;  // Rounds above 65504: overflow to Inf
+        }
+        if (magnitude < 0x38800000) {
+            // Below 2^-14: subnormal, exact scaling then round to even
+            float value;
+            std::memcpy(&value, &magnitude, sizeof(value));
+            return sign | uint16_t(std::nearbyint(value * 16777216.0f));
+        }
+        uint32_t h = (magnitude - 0x38000000) >> 13;
+        uint32_t rest = magnitude & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (h & 1))) {
+            h++;
+        }
+        return sign | uint16_t(h);
+#endif
+    }
+};
+
+// bfloat16: the upper half of an IEEE float (8 exponent, 7 mantissa bits)
+// Same range as float, so no scaling concerns, at lower precision
+struct BFloat16Format {
+    static constexpr double UNIT_ROUNDOFF = 1.0 / 256;  // 2^-8
+
+    static const char* name() { return "bf16"; }
+
+    static float toFloat(uint16_t h) {
+        uint32_t bits = uint32_t(h) << 16;
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static uint16_t fromFloat(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+            return uint16_t((bits >> 16) | 0x40);  // Keep NaN a NaN
+        }
+        bits += 0x7FFF + ((bits >> 16) & 1);       // Round to nearest even
+        return uint16_t(bits >> 16);
+    }
+};
+
+// One amplitude in 16-bit storage: 4 bytes instead of 16
+struct HalfComplex {
+    uint16_t re;
+    uint16_t im;
+};
+
+// Half-Precision State: 16-bit amplitude storage with float arithmetic
+// Each amplitude is stored as two 16-bit numbers (Format = Float16Format
+// or BFloat16Format), a quarter of the memory of a QuantumState: two more
+// qubits fit on the same host. Gates load amplitudes, compute in float
+// and store them back, through the dispatchSparseGate hooks:
+// - permutation gates move stored amplitudes along the index-map cycles;
+//   modular multiplications that are not permutations (multiplier not
+//   coprime to the modulus) have no kernel and are rejected
+// - phase gates and Hadamards convert, compute and convert back; with
+//   F16C, fp16 Hadamards convert four amplitudes per instruction
+// fp16 has a narrow range (subnormal below 6.1e-5), so amplitudes are
+// stored multiplied by 2^(n/2): a uniform superposition is stored as 1,
+// and a basis state as 2^(n/2) ≤ 32768. Gates are linear and act on the
+// scaled values unchanged; reads divide the scale out.
+// Accuracy is about 1e-3 per amplitude (fp16) or 1e-2 (bf16). The error
+// estimate is the larger of the norm drift and √gates · unit roundoff;
+// getMaxError() measures the error against a double-precision reference.
+template <typename Format>
+class HalfPrecisionState {
+public:
+    typedef WideIndex<1> Index;
+
+private:
+    int num_qubits;
+    std::vector<HalfComplex> amplitudes;
+    double scale;       // Stored value = amplitude · scale
+    long gate_count;
+
+    ComplexFloat load(size_t i) const {
+        return ComplexFloat(Format::toFloat(amplitudes[i].re), Format::toFloat(amplitudes[i].im));
+    }
+
+    void store(size_t i, ComplexFloat value) {
+        amplitudes[i].re = Format::fromFloat(value.real());
+        amplitudes[i].im = Format::fromFloat(value.imag());
+    }
+
+#ifdef __F16C__
+    // Four pairs at once: runs of 2^target ≥ 4 amplitudes are contiguous
+    void applyHadamardF16C(int target) {
+        const __m256 inv_sqrt2 = _mm256_set1_ps(float(1.0 / std::sqrt(2.0)));
+        long long run = 1LL << target;
+        long long size = (long long)amplitudes.size();
+        HalfComplex* amps = amplitudes.data();
+        QS_PARALLEL_FOR
+        for (long long base = 0; base < size; base += 2 * run) {
+            for (long long k = 0; k < run; k += 4) {
+                __m128i* low = reinterpret_cast<__m128i*>(amps + base + k);
+                __m128i* high = reinterpret_cast<__m128i*>(amps + base + run + k);
+                __m256 a0 = _mm256_cvtph_ps(_mm_loadu_si128(low));
+                __m256 a1 = _mm256_cvtph_ps(_mm_loadu_si128(high));
+                __m256 sum = _mm256_mul_ps(_mm256_add_ps(a0, a1), inv_sqrt2);
+                __m256 difference = _mm256_mul_ps(_mm256_sub_ps(a0, a1), inv_sqrt2);
+                _mm_storeu_si128(low, _mm256_cvtps_ph(sum, 0));
+                _mm_storeu_si128(high, _mm256_cvtps_ph(difference, 0));
+            }
+        }
+    }
+#endif
+
+public:
+    // Constructor: n qubits in |00...0⟩
+    HalfPrecisionState(int n) : num_qubits(n), gate_count(0) {
+        if (n <= 0 || n > 30) {
+            throw std::invalid_argument("Number of qubits must be between 1 and 30");
+        }
+        scale = std::ldexp(1.0, n / 2);
+        amplitudes.assign(size_t(1) << n, HalfComplex{Format::fromFloat(0.0f), Format::fromFloat(0.0f)});
+        store(0, ComplexFloat(float(scale), 0.0f));
+    }
+
+    // Apply a gate; composite gates are expanded through decompose()
+    void apply(QuantumGate& gate) {
+        if (dispatchSparseGate<1>(gate, num_qubits, *this)) {
+            gate_count++;
+            return;
+        }
+        std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+        if (parts.empty()) {
+            throw std::invalid_argument("Gate has no half-precision kernel and no decomposition");
+        }
+        for (const auto& part : parts) {
+            apply(*part);
+        }
+    }
+
+    // Kernel hooks called by dispatchSparseGate
+
+    template <typename Map>
+    void permute(Map map) {
+        permuteCycles(amplitudes.data(), amplitudes.size(), map);
+    }
+
+    void applyPhase(const Index& mask, double angle) {
+        ComplexFloat factor(float(std::cos(angle)), float(std::sin(angle)));
+        uint64_t bits = mask.words[0];
+        long long size = (long long)amplitudes.size();
+        QS_PARALLEL_FOR
+        for (long long i = 0; i < size; i++) {
+            if ((uint64_t(i) & bits) == bits) {
+                store(i, complexMul(load(i), factor));
+            }
+        }
+    }
+
+    void applyHadamard(int target) {
+#ifdef __F16C__
+        if (std::is_same<Format, Float16Format>::value && target >= 2) {
+            applyHadamardF16C(target);
+            return;
+        }
+#endif
+        const float inv_sqrt2 = float(1.0 / std::sqrt(2.0));
+        long long half = (long long)amplitudes.size() / 2;
+        long long low_mask = (1LL << target) - 1;
+        QS_PARALLEL_FOR
+        for (long long k = 0; k < half; k++) {
+            long long i = ((k & ~low_mask) << 1) | (k & low_mask);
+            long long j = i | (1LL << target);
+            ComplexFloat a0 = load(i);
+            ComplexFloat a1 = load(j);
+            store(i, (a0 + a1) * inv_sqrt2);
+            store(j, (a0 - a1) * inv_sqrt2);
+        }
+    }
+
+    int getNumQubits() const { return num_qubits; }
+    long getGateCount() const { return gate_count; }
+
+    Complex getAmplitude(int index) const {
+        if (index < 0 || index >= (1 << num_qubits)) {
+            throw std::out_of_range("Index out of range");
+        }
+        ComplexFloat value = load(index);
+        return Complex(value.real(), value.imag()) / scale;
+    }
+
+    double getProbability(int index) const {
+        return complexNorm(getAmplitude(index));
+    }
+
+    // Sum of |amplitude|^2, accumulated in double
+    double getNorm() const {
+        double norm = 0.0;
+        long long size = (long long)amplitudes.size();
+        QS_PARALLEL_SUM(norm)
+        for (long long i = 0; i < size; i++) {
+            double re = Format::toFloat(amplitudes[i].re);
+            double im = Format::toFloat(amplitudes[i].im);
+            norm += re * re + im * im;
+        }
+        return norm / (scale * scale);
+    }
+
+    // Expected error per amplitude: norm drift or accumulated rounding
+    double getErrorEstimate() const {
+        double rounding = std::sqrt(double(gate_count) + 1.0) * Format::UNIT_ROUNDOFF;
+        return std::max(std::abs(getNorm() - 1.0), rounding);
+    }
+
+    // Largest amplitude error against a double-precision reference
+    double getMaxError(const QuantumState& reference) const {
+        if (reference.getNumQubits() != num_qubits) {
+            throw std::invalid_argument("Reference state has a different number of qubits");
+        }
+        double error = 0.0;
+        for (int i = 0; i < reference.getStateSize(); i++) {
+            error = std::max(error, std::abs(reference.getAmplitude(i) - getAmplitude(i)));
+        }
+        return error;
+    }
+
+    // Double-precision copy of the state
+    QuantumState toDense() const {
+        QuantumState result(num_qubits);
+        Complex* out = result.data();
+        long long size = (long long)amplitudes.size();
+        QS_PARALLEL_FOR
+        for (long long i = 0; i < size; i++) {
+            ComplexFloat value = load(i);
+            out[i] = Complex(value.real(), value.imag()) / scale;
+        }
+        return result;
+    }
+
+    size_t getMemoryUsage() const {
+        return amplitudes.size() * sizeof(HalfComplex);
+    }
+};
+
+typedef HalfPrecisionState<Float16Format> Float16State;
+typedef HalfPrecisionState<BFloat16Format> BFloat16State;
+
+#endif // HALF_PRECISION_STATE_H
@@ -0,0 +1,295 @@
+#ifndef HYBRID_STATE_H
+#define HYBRID_STATE_H
+
+#include "quantum_state.h"
+#include "quantum_gates.h"
+#include "sparse_state.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Storage form of a HybridState
+enum HybridForm {
+    HYBRID_HASH,    // SparseState: hash map of nonzero amplitudes
+    HYBRID_SORTED,  // SortedSparseState: key-sorted vector of nonzero amplitudes
+    HYBRID_DENSE    // QuantumState: all 2^n amplitudes
+};
+
+// Hybrid State: switches between sparse and dense storage by fill ratio
+// The fill ratio is the number of nonzero amplitudes over 2^num_qubits.
+// A state starts as a hash map, which absorbs the insertions of
+// Hadamards cheaply while few entries exist; it moves to a sorted vector
+// (half the memory per entry, sequential access) as it fills, and to a
+// dense QuantumState once sparse storage stops paying off. Each switch has
+// a lower threshold on the way back, so a state that hovers around one
+// threshold does not convert back and forth on every gate:
+//     hash → sorted at fill ≥ 1/64,   sorted → hash at fill < 1/256
+//     sparse → dense at fill ≥ 1/4,   dense → sorted at fill < 1/16
+// The dense form counts its nonzeros every DENSE_CHECK_INTERVAL gates
+// only, since a count costs as much as a gate. Gates without a sparse
+// kernel or decomposition convert the state to dense before they run.
+class HybridState {
+public:
+    typedef WideIndex<1> Index;
+
+    static const int MAX_QUBITS = 30;
+    static const int DENSE_CHECK_INTERVAL = 8;
+
+private:
+    int num_qubits;
+    HybridForm form;
+    std::unique_ptr<SparseState<1>> hash;
+    std::unique_ptr<SortedSparseState<1>> sorted;
+    std::unique_ptr<QuantumState> dense;
+    size_t dense_nonzeros;      // Nonzero count at the last dense check
+    int gates_since_check;
+    int conversion_count;
+
+    double fill(size_t nonzeros) const {
+        return double(nonzeros) / double(size_t(1) << num_qubits);
+    }
+
+    static Index keyOf(int index) {
+        Index key;
+        key.words[0] = uint64_t(index);
+        return key;
+    }
+
+    // Parallel count of the dense amplitudes at or above the sparse tolerance
+    static size_t countNonzeros(const QuantumState& state) {
+        const Complex* amps = state.data();
+        int size = state.getStateSize();
+        long long nonzeros = 0;
+        QS_PARALLEL_SUM(nonzeros)
+        for (int i = 0; i < size; i++) {
+            if (std::abs(amps[i]) >= SPARSE_ZERO_TOLERANCE) {
+                nonzeros++;
+            }
+        }
+        return size_t(nonzeros);
+    }
+
+    // Key-sorted entries of the current sparse form
+    std::vector<SortedSparseState<1>::Entry> sortedEntries() const {
+        if (form == HYBRID_SORTED) {
+            return sorted->getEntries();
+        }
+        const SparseState<1>::AmplitudeMap& map = hash->getAmplitudes();
+        std::vector<SortedSparseState<1>::Entry> entries(map.begin(), map.end());
+        std::sort(entries.begin(), entries.end(),
+                  [](const SortedSparseState<1>::Entry& lhs, const SortedSparseState<1>::Entry& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+        return entries;
+    }
+
+    // Dense copy of the current sparse form; the scatter runs in parallel
+    // from the sorted form (distinct keys never collide)
+    QuantumState sparseToDense() const {
+        QuantumState result(num_qubits);
+        Complex* amps = result.data();
+        amps[0] = 0.0;
+        if (form == HYBRID_SORTED) {
+            const std::vector<SortedSparseState<1>::Entry>& entries = sorted->getEntries();
+            long long count = (long long)entries.size();
+            QS_PARALLEL_FOR
+            for (long long k = 0; k < count; k++) {
+                amps[entries[k].first.words[0]] = entries[k].second;
+            }
+        } else {
+            for (const auto& entry : hash->getAmplitudes()) {
+                amps[entry.first.words[0]] = entry.second;
+            }
+        }
+        return result;
+    }
+
+    // Sorted entries of the dense state: per-chunk counts, a prefix sum for
+    // the output offsets, then a parallel fill that is sorted by construction
+    std::vector<SortedSparseState<1>::Entry> denseToEntries() const {
+        const Complex* amps = dense->data();
+        int size = dense->getStateSize();
+        const int chunk_count = 64;
+        int chunk = (size + chunk_count - 1) / chunk_count;
+        std::vector<size_t> offsets(chunk_count + 1, 0);
+        QS_PARALLEL_FOR
+        for (int c = 0; c < chunk_count; c++) {
+            size_t count = 0;
+            for (int i = c * chunk; i < std::min(size, (c + 1) * chunk); i++) {
+                if (std::abs(amps[i]) >= SPARSE_ZERO_TOLERANCE) {
+                    count++;
+                }
+            }
+            offsets[c + 1] = count;
+        }
+        for (int c = 0; c < chunk_count; c++) {
+            offsets[c + 1] += offsets[c];
+        }
+
+        std::vector<SortedSparseState<1>::Entry> entries(offsets[chunk_count]);
+        QS_PARALLEL_FOR
+        for (int c = 0; c < chunk_count; c++) {
+            size_t out = offsets[c];
+            for (int i = c * chunk; i < std::min(size, (c + 1) * chunk); i++) {
+                if (std::abs(amps[i]) >= SPARSE_ZERO_TOLERANCE) {
+                    entries[out++] = SortedSparseState<1>::Entry(keyOf(i), amps[i]);
+                }
+            }
+        }
+        return entries;
+    }
+
+    void convertTo(HybridForm target) {
+        if (target == form) {
+            return;
+        }
+        if (target == HYBRID_DENSE) {
+            dense.reset(new QuantumState(sparseToDense()));
+            dense_nonzeros = getNonzeroCount();
+            gates_since_check = 0;
+        } else if (target == HYBRID_SORTED) {
+            std::vector<SortedSparseState<1>::Entry> entries =
+                form == HYBRID_DENSE ? denseToEntries() : sortedEntries();
+            sorted.reset(new SortedSparseState<1>(num_qubits));
+            sorted->assignSorted(std::move(entries));
+        } else {
+            std::vector<SortedSparseState<1>::Entry> entries =
+                form == HYBRID_DENSE ? denseToEntries() : sortedEntries();
+            hash.reset(new SparseState<1>(num_qubits));
+            hash->assign(entries.begin(), entries.end(), entries.size());
+        }
+        if (form == HYBRID_HASH) {
+            hash.reset();
+        } else if (form == HYBRID_SORTED) {
+            sorted.reset();
+        } else {
+            dense.reset();
+        }
+        form = target;
+        conversion_count++;
+    }
+
+    // Pick the form for the current fill ratio, with hysteresis
+    void rebalance() {
+        if (form == HYBRID_DENSE) {
+            if (++gates_since_check < DENSE_CHECK_INTERVAL) {
+                return;
+            }
+            gates_since_check = 0;
+            dense_nonzeros = countNonzeros(*dense);
+            if (fill(dense_nonzeros) < 1.0 / 16) {
+                convertTo(HYBRID_SORTED);
+                rebalance();
+            }
+            return;
+        }
+        double ratio = fill(getNonzeroCount());
+        if (ratio >= 1.0 / 4) {
+            convertTo(HYBRID_DENSE);
+        } else if (form == HYBRID_HASH && ratio >= 1.0 / 64) {
+            convertTo(HYBRID_SORTED);
+        } else if (form == HYBRID_SORTED && ratio < 1.0 / 256) {
+            convertTo(HYBRID_HASH);
+        }
+    }
+
+    // Run the sparse kernel of a known gate on the current sparse form
+    bool applySparse(const QuantumGate& gate) {
+        if (form == HYBRID_HASH) {
+            return dispatchSparseGate<1>(gate, num_qubits, *hash);
+        }
+        return dispatchSparseGate<1>(gate, num_qubits, *sorted);
+    }
+
+public:
+    // Constructor: n qubits in |00...0⟩, stored as a hash map
+    HybridState(int n)
+        : num_qubits(n), form(HYBRID_HASH), dense_nonzeros(0), gates_since_check(0), conversion_count(0) {
+        if (n <= 0 || n > MAX_QUBITS) {
+            throw std::invalid_argument("Number of qubits must be between 1 and " + std::to_string(MAX_QUBITS));
+        }
+        hash.reset(new SparseState<1>(n));
+    }
+
+    // Apply a gate in the current form, then switch form if the fill
+    // ratio crossed a threshold
+    void apply(QuantumGate& gate) {
+        if (form != HYBRID_DENSE) {
+            if (applySparse(gate)) {
+                rebalance();
+                return;
+            }
+            std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+            if (!parts.empty()) {
+                for (const auto& part : parts) {
+                    apply(*part);
+                }
+                return;
+            }
+            convertTo(HYBRID_DENSE);
+        }
+        gate.apply(*dense);
+        rebalance();
+    }
+
+    int getNumQubits() const { return num_qubits; }
+
+    HybridForm getForm() const { return form; }
+
+    // Number of form switches so far
+    int getConversionCount() const { return conversion_count; }
+
+    // Nonzero amplitudes; in dense form, the count at the last check
+    size_t getNonzeroCount() const {
+        if (form == HYBRID_HASH) {
+            return hash->getNonzeroCount();
+        }
+        if (form == HYBRID_SORTED) {
+            return sorted->getNonzeroCount();
+        }
+        return dense_nonzeros;
+    }
+
+    Complex getAmplitude(int index) const {
+        if (index < 0 || index >= (1 << num_qubits)) {
+            throw std::out_of_range("Index out of range");
+        }
+        if (form == HYBRID_HASH) {
+            return hash->getAmplitude(keyOf(index));
+        }
+        if (form == HYBRID_SORTED) {
+            return sorted->getAmplitude(keyOf(index));
+        }
+        return dense->getAmplitude(index);
+    }
+
+    double getProbability(int index) const {
+        return std::norm(getAmplitude(index));
+    }
+
+    // Dense copy of the state
+    QuantumState toDense() const {
+        return form == HYBRID_DENSE ? QuantumState(*dense) : sparseToDense();
+    }
+
+    size_t getMemoryUsage() const {
+        if (form == HYBRID_HASH) {
+            return hash->getMemoryUsage();
+        }
+        if (form == HYBRID_SORTED) {
+            return sorted->getMemoryUsage();
+        }
+        return dense->getMemoryUsage();
+    }
+};
+
+// Name of a hybrid form, for reports
+inline const char* hybridFormName(HybridForm form) {
+    switch (form) {
+        case HYBRID_HASH: return "hash";
+        case HYBRID_SORTED: return "sorted";
+        default: return "dense";
+    }
+}
+
+#endif // HYBRID_STATE_H
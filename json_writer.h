@@ -0,0 +1,160 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Minimal streaming JSON writer for JSON Lines output
+// Each record is built in an in-memory buffer and written to the stream
+// with a single write call followed by '\n' (never std::endl), so batch
+// runs of many jobs do not pay for a flush per line
+class JsonWriter {
+private:
+    std::string buffer;
+    std::vector<bool> needs_comma;  // One entry per open object/array
+    bool after_key;
+
+    // Insert a separating comma if this is not the first element
+    void separate() {
+        if (after_key) {
+            after_key = false;
+            return;
+        }
+        if (!needs_comma.empty()) {
+            if (needs_comma.back()) {
+                buffer += ',';
+            }
+            needs_comma.back() = true;
+        }
+    }
+
+    void writeEscaped(const std::string& text) {
+        buffer += '"';
+        for (char c : text) {
+            switch (c) {
+                case '"':  buffer += "\\\""; break;
+                case '\\': buffer += "\\\\"; break;
+                case '\n': buffer += "\\n"; break;
+                case '\r': buffer += "\\r"; break;
+                case '\t': buffer += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        buffer += escaped;
+                    } else {
+                        buffer += c;
+                    }
+            }
+        }
+        buffer += '"';
+    }
+
+public:
+    JsonWriter() : after_key(false) {
+        buffer.reserve(4096);
+    }
+
+    JsonWriter& beginObject() {
+        separate();
+        buffer += '{';
+        needs_comma.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& endObject() {
+        buffer += '}';
+        needs_comma.pop_back();
+        return *this;
+    }
+
+    JsonWriter& beginArray() {
+        separate();
+        buffer += '[';
+        needs_comma.push_back(false);
+        return *this;
+    }
+
+    JsonWriter& endArray() {
+        buffer += ']';
+        needs_comma.pop_back();
+        return *this;
+    }
+
+    JsonWriter& key(const std::string& name) {
+        separate();
+        writeEscaped(name);
+        buffer += ':';
+        after_key = true;
+        return *this;
+    }
+
+    JsonWriter& value(const std::string& text) {
+        separate();
+        writeEscaped(text);
+        return *this;
+    }
+
+    JsonWriter& value(const char* text) {
+        return value(std::string(text));
+    }
+
+    JsonWriter& value(bool flag) {
+        separate();
+        buffer += flag ? "true" : "false";
+        return *this;
+    }
+
+    JsonWriter& value(int number) {
+        return value(static_cast<int64_t>(number));
+    }
+
+    JsonWriter& value(int64_t number) {
+        separate();
+        buffer += std::to_string(number);
+        return *this;
+    }
+
+    JsonWriter& value(uint64_t number) {
+        separate();
+        buffer += std::to_string(number);
+        return *this;
+    }
+
+    // Non-finite doubles have no JSON representation and are written as null
+    JsonWriter& value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            buffer += "null";
+            return *this;
+        }
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", number);
+        buffer += text;
+        return *this;
+    }
+
+    // Convenience: key followed by value
+    template <typename T>
+    JsonWriter& field(const std::string& name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    // Write the finished record as one line and reset for the next one
+    void writeLine(std::ostream& out) {
+        buffer += '\n';
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+        needs_comma.clear();
+        after_key = false;
+    }
+
+    const std::string& str() const { return buffer; }
+};
+
+#endif // JSON_WRITER_H
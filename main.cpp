@@ -1,8 +1,30 @@
 #include "quantum_state.h"
 #include "quantum_gates.h"
+#include "circuit.h"
+#include "state_cache.h"
+#include "factorized_state.h"
+#include "uniform_state.h"
+#include "sparse_state.h"
+#include "hybrid_state.h"
+#include "mixed_precision_state.h"
+#include "half_precision_state.h"
+#include "numeric_health.h"
+#include "async_executor.h"
+#include "json_writer.h"
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <cstdlib>
+#include <sys/resource.h>
+
+// Number of most likely outcomes reported per job in JSON mode
+const int TOP_OUTCOMES = 8;
 
 // Euclidean algorithm for GCD
 uint64_t gcd(uint64_t a, uint64_t b) {
@@ -14,65 +36,233 @@ uint64_t gcd(uint64_t a, uint64_t b) {
     return a;
 }
 
-int main(int argc, char* argv[]) {
-    std::string filename = "input.txt";
-
-    // Allow command line argument for input file
-    if (argc > 1) {
-        filename = argv[1];
+// One line of the input file: "base modulus num_qubits"
+struct JobConfig {
+    uint64_t base;
+    uint64_t modulus;
+    int num_qubits;
+    std::string parse_error;  // Non-empty if the line could not be parsed
+};
+
+// A measurement outcome split into control (exponent) and target registers
+struct Outcome {
+    int control;
+    uint64_t target;
+    double probability;
+};
+
+// Everything a run produces, collected for the machine-readable output
+struct JobResult {
+    std::string status = "ok";  // "ok", "failed", "non_coprime" or "error"
+    std::string error;
+    uint64_t gcd_value = 0;
+    int target_qubits = 0;
+    int total_qubits = 0;
+    size_t state_bytes = 0;
+    long peak_rss_kb = 0;
+    int num_tests = 0;
+    int num_passed = 0;
+    int gates_skipped = 0;  // Gates restored from the prefix cache
+    int cache_hits = 0;     // Prefix cache lookups during this job
+    int cache_misses = 0;
+    int cache_evictions = 0;
+    std::vector<std::pair<std::string, double>> stage_seconds;
+    std::vector<Outcome> top_outcomes;
+    bool health_checked = false;  // Dense run under --health
+    HealthStats health;
+};
+
+// Options shared by every job of one run
+struct RunOptions {
+    StatePrefixCache* cache = nullptr;  // Prefix cache, or null for none
+    int window = 1;                     // Exponent qubits per modular multiplication
+    // "dense", "factorized", "uniform", "sparse", "hybrid", "mixed", "fp16" or "bf16"
+    std::string representation = "dense";
+    bool health = false;                // Numerical health checks on dense runs
+    bool double_buffer = false;         // Out-of-place permutations on dense runs
+    bool async = false;                 // Pipelined execution on dense runs
+};
+
+// Non-dense state a job runs on instead of the QuantumState; at most one is set
+struct AlternativeState {
+    std::unique_ptr<FactorizedState> factorized;
+    std::unique_ptr<UniformSupportState> uniform;
+    std::unique_ptr<SparseState128> sparse;
+    std::unique_ptr<HybridState> hybrid;
+    std::unique_ptr<MixedPrecisionState> mixed;
+    std::unique_ptr<Float16State> fp16;
+    std::unique_ptr<BFloat16State> bf16;
+};
+
+// Peak resident set size of the process in KB
+long peakMemoryKB() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
     }
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // macOS reports bytes
+#else
+    return usage.ru_maxrss;         // Linux reports kilobytes
+#endif
+}
 
-    // Read configuration
+// Read all jobs from the input file
+// Blank lines and lines starting with '#' are ignored
+bool readJobs(const std::string& filename, std::vector<JobConfig>& jobs) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file '" << filename << "'" << std::endl;
-        return 1;
+        return false;
     }
 
-    uint64_t base, modulus;
-    int num_qubits;
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
 
-    file >> base >> modulus >> num_qubits;
-    file.close();
+        JobConfig job = {0, 0, 0, ""};
+        std::istringstream fields(line);
+        if (!(fields >> job.base >> job.modulus >> job.num_qubits)) {
+            job.parse_error = "Cannot parse line '" + line + "'";
+        }
+        jobs.push_back(job);
+    }
+    return true;
+}
 
-    // Simple validation
-    if (base == 0 || modulus == 0 || num_qubits <= 0) {
-        std::cerr << "Error: All values must be positive" << std::endl;
-        return 1;
+// Apply a circuit, through the prefix cache when one is configured
+// An alternative representation, if set, receives the gates instead of 'state';
+// a health monitor, if given, applies them gate by gate without the cache,
+// and an executor, if given, queues them and returns at once. Cached runs
+// snapshot the state every 'checkpoint_interval' gates and at the end
+void runCircuit(Circuit& circuit, QuantumState& state, AlternativeState& alternative,
+                StatePrefixCache* cache, JobResult& result, HealthMonitor* health = nullptr,
+                AsyncExecutor* executor = nullptr, int checkpoint_interval = 0) {
+    if (alternative.factorized) {
+        alternative.factorized->apply(circuit);
+        return;
+    }
+    if (alternative.uniform) {
+        alternative.uniform->apply(circuit);
+        return;
+    }
+    if (alternative.sparse) {
+        alternative.sparse->apply(circuit);
+        return;
+    }
+    if (alternative.hybrid) {
+        alternative.hybrid->apply(circuit);
+        return;
+    }
+    if (alternative.mixed) {
+        alternative.mixed->apply(circuit);
+        return;
+    }
+    if (alternative.fp16) {
+        alternative.fp16->apply(circuit);
+        return;
+    }
+    if (alternative.bf16) {
+        alternative.bf16->apply(circuit);
+        return;
+    }
+    if (health != nullptr) {
+        health->run(circuit, state);
+        return;
     }
+    if (executor != nullptr) {
+        executor->submit(circuit);
+        return;
+    }
+    if (cache == nullptr) {
+        circuit.apply(state);
+        return;
+    }
+    circuit.apply(state, *cache, checkpoint_interval);
+    result.gates_skipped += circuit.getGatesSkipped();
+}
 
-    if (num_qubits > 10) {
-        std::cerr << "Error: Number of qubits cannot exceed 10" << std::endl;
+// Run the modular exponentiation circuit for one configuration
+// Human-readable progress goes to 'out' and errors to 'err'; both may be
+// null streams when only the structured result is wanted
+// If options.cache is non-null, circuit prefixes shared with earlier jobs
+// are restored from it instead of being recomputed; runs on a non-dense
+// representation (options.representation) bypass the cache, as do dense
+// runs with health checks (options.health) or pipelined execution
+// (options.async)
+int runJob(const JobConfig& job, std::ostream& out, std::ostream& err, JobResult& result,
+           const RunOptions& options) {
+    StatePrefixCache* cache = options.cache;
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point stage_start = Clock::now();
+    auto endStage = [&](const char* name) {
+        Clock::time_point now = Clock::now();
+        result.stage_seconds.push_back(std::make_pair(std::string(name),
+            std::chrono::duration<double>(now - stage_start).count()));
+        stage_start = now;
+    };
+    auto fail = [&](const std::string& message) {
+        err << "Error: " << message << std::endl;
+        result.status = "error";
+        result.error = message;
         return 1;
+    };
+
+    if (!job.parse_error.empty()) {
+        return fail(job.parse_error);
     }
 
-    if (modulus >= 1024) {
-        std::cerr << "Error: Modulus must be < 1024" << std::endl;
-        return 1;
+    uint64_t base = job.base;
+    uint64_t modulus = job.modulus;
+    int num_qubits = job.num_qubits;
+
+    // Simple validation
+    if (base == 0 || modulus == 0 || num_qubits <= 0) {
+        return fail("All values must be positive");
     }
 
-    std::cout << "Configuration loaded:" << std::endl;
-    std::cout << "  Base: " << base << std::endl;
-    std::cout << "  Modulus: " << modulus << std::endl;
-    std::cout << "  Qubits: " << num_qubits << std::endl;
+    // The sparse representation stores 2^num_qubits amplitudes at 128-bit
+    // indices, so it lifts the modulus cap
+    if (options.representation == "sparse") {
+        if (num_qubits > 20) {
+            return fail("Number of qubits cannot exceed 20 in sparse mode");
+        }
+    } else {
+        if (num_qubits > 10) {
+            return fail("Number of qubits cannot exceed 10");
+        }
+
+        if (modulus >= 1024) {
+            return fail("Modulus must be < 1024");
+        }
+    }
+
+    out << "Configuration loaded:" << std::endl;
+    out << "  Base: " << base << std::endl;
+    out << "  Modulus: " << modulus << std::endl;
+    out << "  Qubits: " << num_qubits << std::endl;
 
     // Check if base and modulus are coprime
     uint64_t g = gcd(base, modulus);
+    result.gcd_value = g;
     if (g != 1) {
-        std::cout << "\n=== NOTE ===" << std::endl;
-        std::cout << "gcd(" << base << ", " << modulus << ") = " << g << " ≠ 1" << std::endl;
-        std::cout << "WARNING: The modular multiplication gate is NOT reversible!" << std::endl;
-        std::cout << std::endl;
-        std::cout << "For Shor's algorithm, this means you've already found a non-trivial factor:" << std::endl;
-        std::cout << "  Factor of " << modulus << ": " << g << std::endl;
-        std::cout << "\nThe quantum circuit would not work correctly in this case." << std::endl;
-        std::cout << "Please choose a base coprime to the modulus." << std::endl;
-        std::cout << "========================================" << std::endl;
+        out << "\n=== NOTE ===" << std::endl;
+        out << "gcd(" << base << ", " << modulus << ") = " << g << " ≠ 1" << std::endl;
+        out << "WARNING: The modular multiplication gate is NOT reversible!" << std::endl;
+        out << std::endl;
+        out << "For Shor's algorithm, this means you've already found a non-trivial factor:" << std::endl;
+        out << "  Factor of " << modulus << ": " << g << std::endl;
+        out << "\nThe quantum circuit would not work correctly in this case." << std::endl;
+        out << "Please choose a base coprime to the modulus." << std::endl;
+        out << "========================================" << std::endl;
+        result.status = "non_coprime";
         return 1;
     }
 
-    std::cout << "  gcd(" << base << ", " << modulus << ") = 1 ✓ (reversible)" << std::endl;
-    std::cout << std::endl;
+    out << "  gcd(" << base << ", " << modulus << ") = 1 ✓ (reversible)" << std::endl;
+    out << std::endl;
 
     // ========================================
     // Step 1: Calculate target register size
@@ -86,110 +276,300 @@ int main(int argc, char* argv[]) {
     }
     if (target_qubits == 0) target_qubits = 1;
 
-    std::cout << "Target register size: " << target_qubits << " qubits" << std::endl;
-    std::cout << "Total qubits: " << (num_qubits + target_qubits) << std::endl;
-    std::cout << std::endl;
+    out << "Target register size: " << target_qubits << " qubits" << std::endl;
+    out << "Total qubits: " << (num_qubits + target_qubits) << std::endl;
+    out << std::endl;
 
     // ========================================
     // Step 2: Initialize quantum state
     // ========================================
     int total_qubits = num_qubits + target_qubits;
-    QuantumState state(total_qubits);
+    result.target_qubits = target_qubits;
+    result.total_qubits = total_qubits;
+    endStage("setup");
+
+    // A factorized run keeps the registers as separate factors until the
+    // multiplications entangle them; a uniform run keeps only the support
+    // of the state. Either way the dense vector is only built for
+    // verification, so it starts as a one-qubit placeholder
+    AlternativeState alternative;
+    QuantumState state(options.representation == "dense" ? total_qubits : 1);
+    XGate target_one(0);
+    if (options.representation == "factorized") {
+        alternative.factorized.reset(new FactorizedState(total_qubits));
+        alternative.factorized->apply(target_one);
+    } else if (options.representation == "uniform") {
+        alternative.uniform.reset(new UniformSupportState(total_qubits));
+        alternative.uniform->apply(target_one);
+    } else if (options.representation == "sparse") {
+        alternative.sparse.reset(new SparseState128(total_qubits));
+        alternative.sparse->apply(target_one);
+    } else if (options.representation == "hybrid") {
+        alternative.hybrid.reset(new HybridState(total_qubits));
+        alternative.hybrid->apply(target_one);
+    } else if (options.representation == "mixed") {
+        alternative.mixed.reset(new MixedPrecisionState(total_qubits));
+        alternative.mixed->apply(target_one);
+    } else if (options.representation == "fp16") {
+        alternative.fp16.reset(new Float16State(total_qubits));
+        alternative.fp16->apply(target_one);
+    } else if (options.representation == "bf16") {
+        alternative.bf16.reset(new BFloat16State(total_qubits));
+        alternative.bf16->apply(target_one);
+    } else {
+        state.setDoubleBuffered(options.double_buffer);
+        result.state_bytes = state.getMemoryUsage();
+
+        // Initialize target register to |1⟩ (since a^0 = 1)
+        // Target register occupies qubits 0 to target_qubits-1, so |1⟩ is
+        // the amplitude at index 1
+        state.setAmplitude(0, Complex(0, 0));
+        state.setAmplitude(1, Complex(1, 0));
+    }
 
-    // Initialize target register to |1⟩ (since a^0 = 1)
-    // Target register starts at qubit 'num_qubits'
-    // To set it to |1⟩, we set amplitude at index (1 << num_qubits)
-    state.setAmplitude(0, Complex(0, 0));
-    state.setAmplitude(1 << num_qubits, Complex(1, 0));
+    out << "Initial state: |0⟩^" << num_qubits << " ⊗ |1⟩" << std::endl;
+    out << std::endl;
 
-    std::cout << "Initial state: |0⟩^" << num_qubits << " ⊗ |1⟩" << std::endl;
-    std::cout << std::endl;
+    // Health checks sweep the dense state after every gate, with denormals
+    // flushed to zero on all threads for the rest of the job
+    std::unique_ptr<HealthMonitor> health;
+    std::unique_ptr<FlushDenormalsScope> flush_denormals;
+    if (options.health && options.representation == "dense") {
+        health.reset(new HealthMonitor());
+        flush_denormals.reset(new FlushDenormalsScope());
+    }
+
+    // Pipelined runs hand the state to an executor, which applies each
+    // circuit while this thread precomputes, builds and prints the next;
+    // stage times then measure submission, and "modmult" the remaining wait
+    std::unique_ptr<AsyncExecutor> executor;
+    if (options.async && !health && options.representation == "dense") {
+        executor.reset(new AsyncExecutor(std::move(state)));
+    }
+    endStage("init");
 
     // ========================================
     // Step 3: Apply Hadamard gates to control register
     // ========================================
-    std::cout << "Applying Hadamard gates to control register..." << std::endl;
-    for (int i = 0; i < num_qubits; i++) {
-        HadamardGate H(i);
-        H.apply(state);
+    // Control qubit i is qubit target_qubits + i. Runs through the prefix
+    // cache apply each Hadamard right before the multiplication it controls
+    // instead (Step 5): control qubits not reached yet stay |0⟩, so the
+    // state after the first k steps does not depend on the exponent width
+    // and cached prefixes carry over between widths
+    bool interleave_hadamards = cache != nullptr && options.representation == "dense" && !health && !executor;
+    out << "Applying Hadamard gates to control register..." << std::endl;
+    if (interleave_hadamards) {
+        out << "  (interleaved with the multiplications for the prefix cache)" << std::endl;
+    } else {
+        Circuit hadamard_layer;
+        for (int i = 0; i < num_qubits; i++) {
+            hadamard_layer.add<HadamardGate>(target_qubits + i);
+        }
+        runCircuit(hadamard_layer, state, alternative, cache, result, health.get(), executor.get());
     }
 
-    std::cout << "Control register now in superposition of all exponents 0 to "
-              << ((1 << num_qubits) - 1) << std::endl;
-    std::cout << std::endl;
+    out << "Control register now in superposition of all exponents 0 to "
+        << ((1 << num_qubits) - 1) << std::endl;
+    out << std::endl;
+    endStage("hadamard");
 
     // ========================================
     // Step 4: Precompute powers of base
     // ========================================
-    std::cout << "Precomputing powers of " << base << " mod " << modulus << ":" << std::endl;
+    out << "Precomputing powers of " << base << " mod " << modulus << ":" << std::endl;
     std::vector<uint64_t> powers;
     uint64_t current_power = base % modulus;
 
     for (int i = 0; i < num_qubits; i++) {
         powers.push_back(current_power);
-        std::cout << "  " << base << "^(2^" << i << ") mod " << modulus << " = " << current_power << std::endl;
-        current_power = (current_power * current_power) % modulus;
+        out << "  " << base << "^(2^" << i << ") mod " << modulus << " = " << current_power << std::endl;
+        current_power = mulMod(current_power, current_power, modulus);
     }
-    std::cout << std::endl;
+    out << std::endl;
+    endStage("precompute");
 
     // ========================================
     // Step 5: Apply controlled modular multiplications
     // ========================================
-    std::cout << "Applying controlled modular multiplication gates..." << std::endl;
-
-    for (int i = 0; i < num_qubits; i++) {
-        // For each control qubit i, apply U^(2^i)
-        // where U multiplies by powers[i]
-        ControlledModMultGate gate(i, num_qubits, target_qubits, powers[i], modulus);
-        gate.apply(state);
-        std::cout << "  Applied U^(2^" << i << ") on control qubit " << i
-                  << " (multiplier: " << powers[i] << ")" << std::endl;
+    out << "Applying controlled modular multiplication gates..." << std::endl;
+
+    // Cached runs snapshot after each multiplication step (its Hadamards and
+    // the multiplication), where the circuit of a narrower job would end
+    Circuit modexp;
+    int gates_per_step = options.window <= 1 ? 2 : options.window + 1;
+    if (options.window <= 1) {
+        for (int i = 0; i < num_qubits; i++) {
+            // For each control qubit i, apply U^(2^i)
+            // where U multiplies by powers[i]
+            if (interleave_hadamards) {
+                modexp.add<HadamardGate>(target_qubits + i);
+            }
+            modexp.add<ControlledModMultGate>(target_qubits + i, 0, target_qubits, powers[i], modulus);
+        }
+    } else {
+        // Windowed: control qubits j..j+w-1 with value k select the
+        // multiplier base^(k·2^j) = product of powers[j+b] over set bits b
+        for (int j = 0; j < num_qubits; j += options.window) {
+            int width = std::min(options.window, num_qubits - j);
+            std::vector<uint64_t> table(size_t(1) << width, 1);
+            for (size_t k = 0; k < table.size(); k++) {
+                for (int b = 0; b < width; b++) {
+                    if ((k >> b) & 1) {
+                        table[k] = mulMod(table[k], powers[j + b], modulus);
+                    }
+                }
+            }
+            if (interleave_hadamards) {
+                for (int b = 0; b < width; b++) {
+                    modexp.add<HadamardGate>(target_qubits + j + b);
+                }
+            }
+            modexp.add<LookupModMultGate>(target_qubits + j, width, 0, target_qubits, table, modulus);
+        }
+    }
+    runCircuit(modexp, state, alternative, cache, result, health.get(), executor.get(), gates_per_step);
+    if (health) {
+        const HealthStats& stats = health->getStats();
+        out << "Health: " << stats.checks << " check(s), " << stats.denormals << " denormal(s), "
+            << stats.nonfinite << " non-finite, " << stats.renormalizations << " renormalization(s), max drift "
+            << stats.max_drift << std::endl;
+        result.health_checked = true;
+        result.health = stats;
+    }
+    if (alternative.factorized) {
+        FactorizedState& factorized = *alternative.factorized;
+        out << "Factorized state: " << factorized.getFactorCount() << " factor(s) after "
+            << factorized.getMergeCount() << " merge(s)" << std::endl;
+        result.state_bytes = factorized.getMemoryUsage();
+        state = factorized.toDense();
+    }
+    if (alternative.uniform) {
+        UniformSupportState& uniform = *alternative.uniform;
+        if (uniform.isUniform()) {
+            out << "Uniform-support state: " << uniform.getSupportSize() << " basis states" << std::endl;
+        } else {
+            out << "Uniform-support state: converted to dense" << std::endl;
+        }
+        result.state_bytes = uniform.getMemoryUsage();
+        state = uniform.toDense();
+    }
+    if (alternative.sparse) {
+        out << "Sparse state: " << alternative.sparse->getNonzeroCount() << " nonzero amplitudes" << std::endl;
+        result.state_bytes = alternative.sparse->getMemoryUsage();
+    }
+    if (alternative.hybrid) {
+        HybridState& hybrid = *alternative.hybrid;
+        out << "Hybrid state: " << hybridFormName(hybrid.getForm()) << " form after "
+            << hybrid.getConversionCount() << " conversion(s)" << std::endl;
+        result.state_bytes = hybrid.getMemoryUsage();
+        state = hybrid.toDense();
+    }
+    if (alternative.mixed) {
+        MixedPrecisionState& mixed = *alternative.mixed;
+        if (mixed.isEscalated()) {
+            out << "Mixed-precision state: escalated to double after " << mixed.getEscalationGate()
+                << " gates" << std::endl;
+        } else {
+            out << "Mixed-precision state: single precision, error estimate " << mixed.getErrorEstimate()
+                << std::endl;
+        }
+        result.state_bytes = mixed.getMemoryUsage();
+        state = mixed.toDense();
+    }
+    if (alternative.fp16) {
+        out << "Half-precision state (fp16): error estimate " << alternative.fp16->getErrorEstimate() << std::endl;
+        result.state_bytes = alternative.fp16->getMemoryUsage();
+        state = alternative.fp16->toDense();
+    }
+    if (alternative.bf16) {
+        out << "Half-precision state (bf16): error estimate " << alternative.bf16->getErrorEstimate() << std::endl;
+        result.state_bytes = alternative.bf16->getMemoryUsage();
+        state = alternative.bf16->toDense();
+    }
+    if (options.window <= 1) {
+        for (int i = 0; i < num_qubits; i++) {
+            out << "  Applied U^(2^" << i << ") on control qubit " << i
+                << " (multiplier: " << powers[i] << ")" << std::endl;
+        }
+    } else {
+        for (int j = 0; j < num_qubits; j += options.window) {
+            int last = std::min(j + options.window, num_qubits) - 1;
+            out << "  Applied table lookup on control qubits " << j << "-" << last
+                << " (" << (1 << (last - j + 1)) << " multipliers)" << std::endl;
+        }
     }
-    std::cout << std::endl;
+    if (executor) {
+        state = executor->finish();
+        out << "Async: " << executor->getGatesSubmitted() << " gates submitted, "
+            << executor->getGatesExecuted() << " executed after fusion" << std::endl;
+    }
+    out << std::endl;
+    endStage("modmult");
 
     // ========================================
     // Step 6: Verify results
     // ========================================
-    std::cout << "========================================" << std::endl;
-    std::cout << "Results Verification" << std::endl;
-    std::cout << "========================================" << std::endl;
-    std::cout << std::endl;
+    out << "========================================" << std::endl;
+    out << "Results Verification" << std::endl;
+    out << "========================================" << std::endl;
+    out << std::endl;
 
     // Check each basis state
     int num_tests = 0;
     int num_passed = 0;
 
+    // Collect the outcomes with non-negligible probability, ordered by
+    // target and then control value. State index layout: bits 0 to
+    // target_qubits-1 are target, bits target_qubits to total are control.
+    // A sparse state is read entry by entry, since its index space is far
+    // too large to scan.
+    std::vector<Outcome> outcomes;
+    if (alternative.sparse) {
+        for (const auto& entry : alternative.sparse->getAmplitudes()) {
+            double prob = std::norm(entry.second);
+            if (prob > 1e-10) {
+                outcomes.push_back({int(entry.first.field(target_qubits, num_qubits)),
+                                    entry.first.field(0, target_qubits), prob});
+            }
+        }
+    } else {
+        for (int idx = 0; idx < state.getStateSize(); idx++) {
+            double prob = state.getProbability(idx);
+            if (prob > 1e-10) {
+                outcomes.push_back({idx >> target_qubits, uint64_t(idx & ((1 << target_qubits) - 1)), prob});
+            }
+        }
+    }
+    std::sort(outcomes.begin(), outcomes.end(), [](const Outcome& lhs, const Outcome& rhs) {
+        return lhs.target != rhs.target ? lhs.target < rhs.target : lhs.control < rhs.control;
+    });
+
     // Debug: Print all non-zero probability states
-    std::cout << "Debug: All quantum states with non-zero probability:" << std::endl;
+    out << "Debug: All quantum states with non-zero probability:" << std::endl;
     int non_zero_count = 0;
-    for (int idx = 0; idx < state.getStateSize(); idx++) {
-        double prob = state.getProbability(idx);
-        if (prob > 0.001) {
-            // State index layout: bits 0 to num_qubits-1 are control
-            // bits num_qubits to total are target
-            int control = idx & ((1 << num_qubits) - 1);  // Lower bits: control
-            int target = idx >> num_qubits;  // Upper bits: target
-            std::cout << "  |" << control << "⟩⊗|" << target << "⟩: P = " << prob << std::endl;
+    for (const Outcome& outcome : outcomes) {
+        if (outcome.probability > 0.001) {
+            out << "  |" << outcome.control << "⟩⊗|" << outcome.target << "⟩: P = " << outcome.probability
+                << std::endl;
             non_zero_count++;
         }
     }
-    std::cout << "Total non-zero states: " << non_zero_count << std::endl;
-    std::cout << std::endl;
+    out << "Total non-zero states: " << non_zero_count << std::endl;
+    out << std::endl;
+
+    // Most likely target value for each control value
+    std::vector<double> max_probs(size_t(1) << num_qubits, 0.0);
+    std::vector<uint64_t> most_likely_targets(size_t(1) << num_qubits, 0);
+    for (const Outcome& outcome : outcomes) {
+        if (outcome.probability > max_probs[outcome.control]) {
+            max_probs[outcome.control] = outcome.probability;
+            most_likely_targets[outcome.control] = outcome.target;
+        }
+    }
 
     for (int x = 0; x < (1 << num_qubits); x++) {
-        // Find the actual state after computation
-        // State index = (target << num_qubits) | control
-        double max_prob = 0;
-        int most_likely_target = 0;
-
-        for (int y = 0; y < (1 << target_qubits); y++) {
-            int idx = (y << num_qubits) | x;  // target in upper bits, control in lower
-            double prob = state.getProbability(idx);
-            if (prob > max_prob) {
-                max_prob = prob;
-                most_likely_target = y;
-            }
-        }
+        double max_prob = max_probs[x];
+        uint64_t most_likely_target = most_likely_targets[x];
 
         // Classical computation
         uint64_t classical_result = 1;
@@ -198,9 +578,9 @@ int main(int argc, char* argv[]) {
 
         for (int bit = 0; bit < num_qubits; bit++) {
             if ((exponent >> bit) & 1) {
-                classical_result = (classical_result * base_pow) % modulus;
+                classical_result = mulMod(classical_result, base_pow, modulus);
             }
-            base_pow = (base_pow * base_pow) % modulus;
+            base_pow = mulMod(base_pow, base_pow, modulus);
         }
 
         // Check if quantum result matches classical
@@ -215,16 +595,256 @@ int main(int argc, char* argv[]) {
 
         num_tests++;
     }
+    endStage("verify");
+
+    // Keep the most likely outcomes for the structured result
+    size_t top = std::min(outcomes.size(), static_cast<size_t>(TOP_OUTCOMES));
+    std::partial_sort(outcomes.begin(), outcomes.begin() + top, outcomes.end(),
+                      [](const Outcome& lhs, const Outcome& rhs) {
+                          return lhs.probability > rhs.probability;
+                      });
+    outcomes.resize(top);
+    result.top_outcomes = outcomes;
+    result.num_tests = num_tests;
+    result.num_passed = num_passed;
+    if (num_passed != num_tests) {
+        result.status = "failed";
+    }
 
     // Summary
-    std::cout << "========================================" << std::endl;
-    std::cout << "Summary: " << num_passed << "/" << num_tests << " tests passed" << std::endl;
+    out << "========================================" << std::endl;
+    out << "Summary: " << num_passed << "/" << num_tests << " tests passed" << std::endl;
     if (num_passed == num_tests) {
-        std::cout << "✓ All tests passed!" << std::endl;
+        out << "✓ All tests passed!" << std::endl;
     } else {
-        std::cout << "✗ Some tests failed" << std::endl;
+        out << "✗ Some tests failed" << std::endl;
     }
-    std::cout << "========================================" << std::endl;
+    out << "========================================" << std::endl;
 
     return 0;
 }
+
+// Serialize one job as a single JSON Lines record
+void writeJobJson(JsonWriter& json, int job_index, const JobConfig& job, const JobResult& result,
+                  const RunOptions& options) {
+    const StatePrefixCache* cache = options.cache;
+    json.beginObject();
+    json.field("job", job_index);
+    json.field("status", result.status);
+    if (!result.error.empty()) {
+        json.field("error", result.error);
+    }
+
+    json.key("config").beginObject();
+    json.field("base", job.base);
+    json.field("modulus", job.modulus);
+    json.field("num_qubits", job.num_qubits);
+    json.field("window", options.window);
+    json.field("representation", options.representation);
+    json.endObject();
+
+    json.key("registers").beginObject();
+    json.field("control_qubits", job.num_qubits);
+    json.field("target_qubits", result.target_qubits);
+    json.field("total_qubits", result.total_qubits);
+    json.endObject();
+
+    if (result.gcd_value != 0) {
+        json.field("gcd", result.gcd_value);
+    }
+
+    json.key("timings_s").beginObject();
+    for (size_t i = 0; i < result.stage_seconds.size(); i++) {
+        json.field(result.stage_seconds[i].first, result.stage_seconds[i].second);
+    }
+    json.endObject();
+
+    json.key("memory").beginObject();
+    json.field("state_bytes", static_cast<uint64_t>(result.state_bytes));
+    json.field("peak_rss_kb", static_cast<int64_t>(result.peak_rss_kb));
+    json.endObject();
+
+    if (cache != nullptr) {
+        json.key("cache").beginObject();
+        json.field("gates_skipped", result.gates_skipped);
+        json.field("hits", result.cache_hits);
+        json.field("misses", result.cache_misses);
+        json.field("evictions", result.cache_evictions);
+        json.field("entries", static_cast<uint64_t>(cache->getEntryCount()));
+        json.field("memory_bytes", static_cast<uint64_t>(cache->getMemoryUsed()));
+        json.endObject();
+    }
+
+    if (result.health_checked) {
+        json.key("health").beginObject();
+        json.field("checks", result.health.checks);
+        json.field("denormals", static_cast<int64_t>(result.health.denormals));
+        json.field("nonfinite", static_cast<int64_t>(result.health.nonfinite));
+        json.field("renormalizations", result.health.renormalizations);
+        json.field("max_drift", result.health.max_drift);
+        json.field("violations", static_cast<uint64_t>(result.health.violations.size()));
+        json.endObject();
+    }
+
+    json.key("verification").beginObject();
+    json.field("tests", result.num_tests);
+    json.field("passed", result.num_passed);
+    json.endObject();
+
+    json.key("top_outcomes").beginArray();
+    for (const Outcome& outcome : result.top_outcomes) {
+        json.beginObject();
+        json.field("control", outcome.control);
+        json.field("target", outcome.target);
+        json.field("probability", outcome.probability);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+}
+
+int main(int argc, char* argv[]) {
+    std::string filename = "input.txt";
+    std::string json_path;  // Empty: human-readable output only
+    double cache_mb = 0;    // 0: no prefix cache
+    std::string cache_dir;
+    RunOptions options;
+
+    // Usage: main [input_file] [--json <output.jsonl | ->]
+    //             [--cache-mb <megabytes>] [--cache-dir <directory>]
+    //             [--window <w>] [--state <dense | factorized | uniform | sparse | hybrid | mixed | fp16 | bf16>]
+    //             [--health] [--double-buffer] [--async]
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" || arg == "--cache-mb" || arg == "--cache-dir" || arg == "--window" ||
+            arg == "--state") {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value" << std::endl;
+                return 1;
+            }
+            std::string value = argv[++i];
+            if (arg == "--json") {
+                json_path = value;
+            } else if (arg == "--cache-mb") {
+                cache_mb = std::atof(value.c_str());
+            } else if (arg == "--window") {
+                options.window = std::atoi(value.c_str());
+                if (options.window < 1 || options.window > 10) {
+                    std::cerr << "Error: --window must be between 1 and 10" << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--state") {
+                if (value != "dense" && value != "factorized" && value != "uniform" && value != "sparse" &&
+                    value != "hybrid" && value != "mixed" && value != "fp16" && value != "bf16") {
+                    std::cerr << "Error: --state must be 'dense', 'factorized', 'uniform', 'sparse', 'hybrid', "
+                              << "'mixed', 'fp16' or 'bf16'"
+                              << std::endl;
+                    return 1;
+                }
+                options.representation = value;
+            } else {
+                cache_dir = value;
+            }
+        } else if (arg == "--health") {
+            options.health = true;
+        } else if (arg == "--double-buffer") {
+            options.double_buffer = true;
+        } else if (arg == "--async") {
+            options.async = true;
+        } else {
+            filename = arg;
+        }
+    }
+
+    // Options that only some runs support are rejected, not ignored
+    if (options.health && options.representation != "dense") {
+        std::cerr << "Error: --health requires --state dense" << std::endl;
+        return 1;
+    }
+    if (options.double_buffer && (options.representation != "dense" || options.async)) {
+        std::cerr << "Error: --double-buffer requires --state dense and cannot be combined with --async"
+                  << std::endl;
+        return 1;
+    }
+    if (options.async && (options.representation != "dense" || options.health)) {
+        std::cerr << "Error: --async requires --state dense and cannot be combined with --health" << std::endl;
+        return 1;
+    }
+
+    // Read configuration
+    std::vector<JobConfig> jobs;
+    if (!readJobs(filename, jobs)) {
+        std::cerr << "Error: Cannot open file '" << filename << "'" << std::endl;
+        return 1;
+    }
+    if (jobs.empty()) {
+        std::cerr << "Error: No configuration found in '" << filename << "'" << std::endl;
+        return 1;
+    }
+
+    // Optional prefix cache shared by all jobs of this run
+    std::unique_ptr<StatePrefixCache> cache;
+    if (cache_mb > 0 || !cache_dir.empty()) {
+        try {
+            cache.reset(new StatePrefixCache(static_cast<size_t>(cache_mb * 1024 * 1024), cache_dir));
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    options.cache = cache.get();
+
+    // Human-readable mode: progress and errors go to the terminal
+    if (json_path.empty()) {
+        int exit_code = 0;
+        for (const JobConfig& job : jobs) {
+            JobResult result;
+            if (runJob(job, std::cout, std::cerr, result, options) != 0) {
+                exit_code = 1;
+            }
+        }
+        if (cache) {
+            cache->persist();
+        }
+        return exit_code;
+    }
+
+    // JSON Lines mode: one record per job, text output suppressed
+    std::ofstream json_file;
+    if (json_path != "-") {
+        json_file.open(json_path, std::ios::out | std::ios::trunc);
+        if (!json_file.is_open()) {
+            std::cerr << "Error: Cannot open JSON output '" << json_path << "'" << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& json_out = (json_path == "-") ? std::cout : json_file;
+    std::ostream null_stream(nullptr);
+
+    JsonWriter json;
+    int exit_code = 0;
+    for (size_t i = 0; i < jobs.size(); i++) {
+        JobResult result;
+        int hits = cache ? cache->getHits() : 0;
+        int misses = cache ? cache->getMisses() : 0;
+        int evictions = cache ? cache->getEvictions() : 0;
+        if (runJob(jobs[i], null_stream, null_stream, result, options) != 0) {
+            exit_code = 1;
+        }
+        if (cache) {
+            result.cache_hits = cache->getHits() - hits;
+            result.cache_misses = cache->getMisses() - misses;
+            result.cache_evictions = cache->getEvictions() - evictions;
+        }
+        result.peak_rss_kb = peakMemoryKB();
+        writeJobJson(json, static_cast<int>(i), jobs[i], result, options);
+        json.writeLine(json_out);
+    }
+    json_out.flush();
+    if (cache) {
+        cache->persist();
+    }
+
+    return exit_code;
+}
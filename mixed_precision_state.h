@@ -0,0 +1,269 @@
+#ifndef MIXED_PRECISION_STATE_H
+#define MIXED_PRECISION_STATE_H
+
+#include "quantum_state.h"
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include "sparse_state.h"
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+typedef std::complex<float> ComplexFloat;
+
+// Move values[i] to values[map(i)] in place, one cycle of the permutation
+// at a time, with one visited bit per element instead of a second buffer
+// 'map' takes and returns a WideIndex<1> and must be a bijection; a walk
+// that leaves the range or reaches an index a second time throws
+// std::invalid_argument instead of looping, with 'values' partly moved
+template <typename T, typename Map>
+void permuteCycles(T* values, size_t size, Map map) {
+    std::vector<uint64_t> visited((size + 63) / 64, 0);
+    WideIndex<1> key;
+    for (size_t start = 0; start < size; start++) {
+        if ((visited[start >> 6] >> (start & 63)) & 1) {
+            continue;
+        }
+        visited[start >> 6] |= uint64_t(1) << (start & 63);
+        key.words[0] = start;
+        size_t next = size_t(map(key).words[0]);
+        T carried = values[start];
+        while (next != start) {
+            if (next >= size || ((visited[next >> 6] >> (next & 63)) & 1)) {
+                throw std::invalid_argument("Index map is not a permutation");
+            }
+            visited[next >> 6] |= uint64_t(1) << (next & 63);
+            std::swap(carried, values[next]);
+            key.words[0] = next;
+            next = size_t(map(key).words[0]);
+        }
+        values[start] = carried;
+    }
+}
+
+// Mixed-Precision State: single-precision amplitudes that escalate to double
+// Stores 2^n complex<float> amplitudes, half the memory of a QuantumState,
+// and runs the known gates on them through dispatchSparseGate (every
+// index is stored, so the sparse kernels become dense float kernels):
+// - permutation gates move amplitudes along the cycles of the index map,
+//   in place, with one visited bit per amplitude; modular multiplications
+//   that are not permutations (multiplier not coprime to the modulus) have
+//   no float kernel and escalate like any other unknown gate
+// - phase gates and Hadamards update amplitudes in place
+// Every check_interval gates the norm is accumulated in double. The drift
+// |norm - 1|, or the expected rounding error √gates · FLT_EPSILON when
+// larger, is the error estimate; once it exceeds the tolerance the state
+// converts itself to a double-precision QuantumState, which then receives
+// all further gates. The conversion is a copy, so the float and double
+// amplitudes (24 bytes each) coexist until it finishes. If a memory limit
+// is set and that peak would not fit, the state stays in float,
+// renormalizes and records a warning instead. Norms and probabilities
+// always accumulate in double.
+class MixedPrecisionState {
+private:
+    int num_qubits;
+    std::vector<ComplexFloat> single;
+    std::unique_ptr<QuantumState> dense;  // Non-null once escalated
+    double tolerance;
+    int check_interval;
+    size_t memory_limit;                  // Peak bytes while escalating; 0 for no limit
+    int gates_since_check;
+    long gate_count;
+    int check_count;
+    long escalation_gate;                 // Gate count at escalation, -1 if none
+    double last_estimate;
+    bool drift_warning;
+
+    void escalate() {
+        dense.reset(new QuantumState(toDense()));
+        single.clear();
+        single.shrink_to_fit();
+        escalation_gate = gate_count;
+    }
+
+    void checkPrecision() {
+        gates_since_check = 0;
+        check_count++;
+        double norm = getNorm();
+        double rounding = std::sqrt(double(gate_count)) * FLT_EPSILON;
+        last_estimate = std::max(std::abs(norm - 1.0), rounding);
+        if (last_estimate <= tolerance) {
+            return;
+        }
+        size_t peak_bytes = single.size() * (sizeof(ComplexFloat) + sizeof(Complex));
+        if (memory_limit == 0 || peak_bytes <= memory_limit) {
+            escalate();
+            return;
+        }
+        // No room for double precision: keep float, undo the drift
+        drift_warning = true;
+        float factor = float(1.0 / std::sqrt(norm));
+        ComplexFloat* amps = single.data();
+        long long size = (long long)single.size();
+        QS_PARALLEL_FOR
+        for (long long i = 0; i < size; i++) {
+            amps[i] *= factor;
+        }
+    }
+
+public:
+    typedef WideIndex<1> Index;
+
+    // Constructor: n qubits in |00...0⟩, checked every check_interval
+    // gates against 'tolerance'
+    MixedPrecisionState(int n, double tolerance = 1e-5, int check_interval = 16, size_t memory_limit = 0)
+        : num_qubits(n), tolerance(tolerance), check_interval(check_interval), memory_limit(memory_limit),
+          gates_since_check(0), gate_count(0), check_count(0), escalation_gate(-1), last_estimate(0.0),
+          drift_warning(false) {
+        if (n <= 0 || n > 30) {
+            throw std::invalid_argument("Number of qubits must be between 1 and 30");
+        }
+        if (tolerance <= 0.0 || check_interval <= 0) {
+            throw std::invalid_argument("Tolerance and check interval must be positive");
+        }
+        single.assign(size_t(1) << n, ComplexFloat(0, 0));
+        single[0] = ComplexFloat(1, 0);
+    }
+
+    // Apply a gate; composite gates are expanded through decompose() and
+    // gates without a float kernel escalate the state to double first
+    void apply(QuantumGate& gate) {
+        if (dense) {
+            gate.apply(*dense);
+            gate_count++;
+            return;
+        }
+        if (!dispatchSparseGate<1>(gate, num_qubits, *this)) {
+            std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+            if (!parts.empty()) {
+                for (const auto& part : parts) {
+                    apply(*part);
+                }
+                return;
+            }
+            escalate();
+            gate.apply(*dense);
+        }
+        gate_count++;
+        if (!dense && ++gates_since_check >= check_interval) {
+            checkPrecision();
+        }
+    }
+
+    // Kernel hooks called by dispatchSparseGate
+
+    template <typename Map>
+    void permute(Map map) {
+        permuteCycles(single.data(), single.size(), map);
+    }
+
+    void applyPhase(const Index& mask, double angle) {
+        ComplexFloat factor(float(std::cos(angle)), float(std::sin(angle)));
+        uint64_t bits = mask.words[0];
+        ComplexFloat* amps = single.data();
+        long long size = (long long)single.size();
+        QS_PARALLEL_FOR
+        for (long long i = 0; i < size; i++) {
+            if ((uint64_t(i) & bits) == bits) {
+                amps[i] = complexMul(amps[i], factor);
+            }
+        }
+    }
+
+    void applyHadamard(int target) {
+        const float inv_sqrt2 = float(1.0 / std::sqrt(2.0));
+        long long half = (long long)single.size() / 2;
+        long long low_mask = (1LL << target) - 1;
+        ComplexFloat* amps = single.data();
+        QS_PARALLEL_FOR
+        for (long long k = 0; k < half; k++) {
+            long long i = ((k & ~low_mask) << 1) | (k & low_mask);
+            long long j = i | (1LL << target);
+            ComplexFloat a0 = amps[i];
+            ComplexFloat a1 = amps[j];
+            amps[i] = (a0 + a1) * inv_sqrt2;
+            amps[j] = (a0 - a1) * inv_sqrt2;
+        }
+    }
+
+    int getNumQubits() const { return num_qubits; }
+
+    // True once the state runs in double precision
+    bool isEscalated() const { return bool(dense); }
+
+    // Gates applied before escalation, or -1 if still in float
+    long getEscalationGate() const { return escalation_gate; }
+
+    long getGateCount() const { return gate_count; }
+    int getCheckCount() const { return check_count; }
+
+    // Error estimate at the last check
+    double getErrorEstimate() const { return last_estimate; }
+
+    // True if drift exceeded the tolerance but the escalation peak (float
+    // and double copies together) did not fit the memory limit
+    bool hasDriftWarning() const { return drift_warning; }
+
+    // Sum of |amplitude|^2, accumulated in double
+    double getNorm() const {
+        if (dense) {
+            double norm = 0.0;
+            const Complex* amps = dense->data();
+            int size = dense->getStateSize();
+            QS_PARALLEL_SUM(norm)
+            for (int i = 0; i < size; i++) {
+                norm += complexNorm(amps[i]);
+            }
+            return norm;
+        }
+        double norm = 0.0;
+        const ComplexFloat* amps = single.data();
+        long long size = (long long)single.size();
+        QS_PARALLEL_SUM(norm)
+        for (long long i = 0; i < size; i++) {
+            double re = amps[i].real();
+            double im = amps[i].imag();
+            norm += re * re + im * im;
+        }
+        return norm;
+    }
+
+    Complex getAmplitude(int index) const {
+        if (index < 0 || index >= (1 << num_qubits)) {
+            throw std::out_of_range("Index out of range");
+        }
+        if (dense) {
+            return dense->getAmplitude(index);
+        }
+        return Complex(single[index].real(), single[index].imag());
+    }
+
+    // Probability in double precision
+    double getProbability(int index) const {
+        return complexNorm(getAmplitude(index));
+    }
+
+    // Double-precision copy of the state
+    QuantumState toDense() const {
+        if (dense) {
+            return QuantumState(*dense);
+        }
+        QuantumState result(num_qubits);
+        Complex* amps = result.data();
+        const ComplexFloat* source = single.data();
+        long long size = (long long)single.size();
+        QS_PARALLEL_FOR
+        for (long long i = 0; i < size; i++) {
+            amps[i] = Complex(source[i].real(), source[i].imag());
+        }
+        return result;
+    }
+
+    size_t getMemoryUsage() const {
+        return dense ? dense->getMemoryUsage() : single.size() * sizeof(ComplexFloat);
+    }
+};
+
+#endif // MIXED_PRECISION_STATE_H
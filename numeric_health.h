@@ -0,0 +1,246 @@
+#ifndef NUMERIC_HEALTH_H
+#define NUMERIC_HEALTH_H
+
+#include "quantum_state.h"
+#include "circuit.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define QS_HAS_MXCSR 1
+#endif
+
+// Flush-to-zero / denormals-are-zero for the lifetime of the scope
+// Sets the FTZ and DAZ bits of the SSE control register on the calling
+// thread and, in OpenMP builds, on every worker thread of the default
+// team, so results that would be denormal become zero and denormal inputs
+// read as zero: x86 otherwise takes a microcode assist 10-100× slower
+// than a normal operation for each of them. The previous mode is restored
+// on destruction. On targets without SSE this does nothing and
+// isSupported() is false.
+class FlushDenormalsScope {
+private:
+    unsigned int previous;
+
+    static const unsigned int FLUSH_BITS = 0x8040;  // FTZ (bit 15) | DAZ (bit 6)
+
+    static void setOnAllThreads(unsigned int bits) {
+#ifdef QS_HAS_MXCSR
+#ifdef _OPENMP
+        QS_PRAGMA(omp parallel)
+        {
+            _mm_setcsr((_mm_getcsr() & ~FLUSH_BITS) | bits);
+        }
+#endif
+        _mm_setcsr((_mm_getcsr() & ~FLUSH_BITS) | bits);
+#else
+        (void)bits;
+#endif
+    }
+
+public:
+    FlushDenormalsScope() : previous(0) {
+#ifdef QS_HAS_MXCSR
+        previous = _mm_getcsr() & FLUSH_BITS;
+#endif
+        setOnAllThreads(FLUSH_BITS);
+    }
+
+    ~FlushDenormalsScope() {
+        setOnAllThreads(previous);
+    }
+
+    FlushDenormalsScope(const FlushDenormalsScope&) = delete;
+    FlushDenormalsScope& operator=(const FlushDenormalsScope&) = delete;
+
+    static bool isSupported() {
+#ifdef QS_HAS_MXCSR
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // True if the calling thread currently flushes denormals
+    static bool isActive() {
+#ifdef QS_HAS_MXCSR
+        return (_mm_getcsr() & FLUSH_BITS) == FLUSH_BITS;
+#else
+        return false;
+#endif
+    }
+};
+
+// One finding of a health check
+struct HealthViolation {
+    long gate;          // Gates applied when the check ran
+    std::string kind;   // "denormal", "nonfinite" or "drift"
+    int block;          // Block of BLOCK_SIZE amplitudes, -1 for the whole state
+    double value;       // Count in the block, or the norm drift
+};
+
+// Running totals of a HealthMonitor
+struct HealthStats {
+    long gates = 0;
+    int checks = 0;
+    long denormals = 0;        // Denormal components found (then flushed)
+    long nonfinite = 0;        // NaN or infinite components found
+    int renormalizations = 0;
+    double max_drift = 0.0;    // Largest |norm - 1| seen by a check
+    double last_norm = 1.0;
+    std::vector<HealthViolation> violations;
+};
+
+// Health Monitor: opt-in numerical checks between gates
+// Applies gates to a dense state and, every check_interval gates, sweeps
+// the amplitudes once in blocks of BLOCK_SIZE (in parallel with OpenMP),
+// counting denormal and non-finite components per block and summing the
+// norm in double. Blocks with findings are recorded as violations. When
+// the drift |norm - 1| exceeds the tolerance or denormals were found, one
+// fused pass rescales every amplitude by 1/√norm and flushes denormals to
+// zero. Non-finite values cannot be repaired; they are reported and the
+// state is left as it is (isHealthy() turns false).
+class HealthMonitor {
+public:
+    static const int BLOCK_SIZE = 4096;
+
+private:
+    double tolerance;
+    int check_interval;
+    int gates_since_check;
+    HealthStats stats;
+
+    static bool isDenormal(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return ((bits >> 52) & 0x7FF) == 0 && (bits << 12) != 0;
+    }
+
+    static bool isNonFinite(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return ((bits >> 52) & 0x7FF) == 0x7FF;
+    }
+
+    // Scale by 'factor' and zero denormal components in one pass
+    static void renormalize(QuantumState& state, double factor) {
+        double* values = reinterpret_cast<double*>(state.data());
+        long long count = 2LL * state.getStateSize();
+        QS_PARALLEL_FOR
+        for (long long k = 0; k < count; k++) {
+            double value = values[k] * factor;
+            values[k] = isDenormal(value) ? 0.0 : value;
+        }
+    }
+
+public:
+    // Constructor: renormalize when |norm - 1| exceeds 'tolerance', check
+    // every 'check_interval' gates
+    HealthMonitor(double tolerance = 1e-10, int check_interval = 1)
+        : tolerance(tolerance), check_interval(check_interval), gates_since_check(0) {
+        if (tolerance <= 0.0 || check_interval <= 0) {
+            throw std::invalid_argument("Tolerance and check interval must be positive");
+        }
+    }
+
+    // Apply one gate, then check if the interval is due
+    void apply(QuantumGate& gate, QuantumState& state) {
+        gate.apply(state);
+        stats.gates++;
+        if (++gates_since_check >= check_interval) {
+            check(state);
+        }
+    }
+
+    // Apply every gate of a circuit through the monitor
+    void run(const Circuit& circuit, QuantumState& state) {
+        for (const auto& gate : circuit.getGates()) {
+            apply(*gate, state);
+        }
+    }
+
+    // Sweep the state now; returns true if it was healthy (no findings and
+    // drift within tolerance)
+    bool check(QuantumState& state) {
+        gates_since_check = 0;
+        stats.checks++;
+        const double* values = reinterpret_cast<const double*>(state.data());
+        long long count = 2LL * state.getStateSize();
+        int blocks = int((count / 2 + BLOCK_SIZE - 1) / BLOCK_SIZE);
+        std::vector<double> block_norm(blocks, 0.0);
+        std::vector<long> block_denormals(blocks, 0);
+        std::vector<long> block_nonfinite(blocks, 0);
+
+        QS_PARALLEL_FOR
+        for (int b = 0; b < blocks; b++) {
+            long long begin = 2LL * b * BLOCK_SIZE;
+            long long end = std::min(count, begin + 2LL * BLOCK_SIZE);
+            double norm = 0.0;
+            long denormals = 0;
+            long nonfinite = 0;
+            for (long long k = begin; k < end; k++) {
+                double value = values[k];
+                if (isNonFinite(value)) {
+                    nonfinite++;
+                    continue;
+                }
+                denormals += isDenormal(value) ? 1 : 0;
+                norm += value * value;
+            }
+            block_norm[b] = norm;
+            block_denormals[b] = denormals;
+            block_nonfinite[b] = nonfinite;
+        }
+
+        double norm = 0.0;
+        long denormals = 0;
+        long nonfinite = 0;
+        for (int b = 0; b < blocks; b++) {
+            norm += block_norm[b];
+            denormals += block_denormals[b];
+            nonfinite += block_nonfinite[b];
+            if (block_denormals[b] > 0) {
+                stats.violations.push_back({stats.gates, "denormal", b, double(block_denormals[b])});
+            }
+            if (block_nonfinite[b] > 0) {
+                stats.violations.push_back({stats.gates, "nonfinite", b, double(block_nonfinite[b])});
+            }
+        }
+        stats.denormals += denormals;
+        stats.nonfinite += nonfinite;
+        stats.last_norm = norm;
+
+        double drift = std::abs(norm - 1.0);
+        stats.max_drift = std::max(stats.max_drift, drift);
+        if (nonfinite > 0) {
+            return false;
+        }
+        bool drifted = drift > tolerance;
+        if (drifted) {
+            stats.violations.push_back({stats.gates, "drift", -1, drift});
+        }
+        if (drifted || denormals > 0) {
+            renormalize(state, drifted && norm > 0.0 ? 1.0 / std::sqrt(norm) : 1.0);
+            stats.renormalizations += drifted ? 1 : 0;
+        }
+        return !drifted && denormals == 0;
+    }
+
+    const HealthStats& getStats() const { return stats; }
+
+    // False once a non-finite amplitude was found
+    bool isHealthy() const { return stats.nonfinite == 0; }
+
+    void resetStats() {
+        stats = HealthStats();
+        gates_since_check = 0;
+    }
+};
+
+#endif // NUMERIC_HEALTH_H
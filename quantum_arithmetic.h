@@ -2,8 +2,53 @@
 #define QUANTUM_ARITHMETIC_H
 
 #include "quantum_gates.h"
+#include "complex_math.h"
+#include <cmath>
+#include <cstdint>
 #include <vector>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// How composite arithmetic gates are executed
+// GATE_LEVEL applies the decomposed gate sequence, one full sweep per gate.
+// EMULATED applies the same net basis-state permutation directly, computing
+// each index's image with classical bit operations in a single pass.
+// Both give identical results; GATE_LEVEL is the reference.
+enum ArithmeticMode {
+    GATE_LEVEL,
+    EMULATED
+};
+
+// Apply a basis-state permutation in one pass: |i⟩ → |map(i)⟩
+// 'map' must be a bijection on [0, state_size). Like ControlledModMultGate,
+// the amplitudes are snapshotted and only moved entries are written back;
+// double-buffered states scatter into the back buffer instead of copying.
+template <typename IndexMap>
+void applyIndexPermutation(QuantumState& state, IndexMap map) {
+    int state_size = state.getStateSize();
+    Complex* amplitudes = state.data();
+    if (state.isDoubleBuffered()) {
+        Complex* out = state.backData();
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            out[map(i)] = amplitudes[i];
+        }
+        state.swapBuffers();
+        return;
+    }
+    std::vector<Complex> old_amplitudes(amplitudes, amplitudes + state_size);
+
+    QS_PARALLEL_FOR
+    for (int i = 0; i < state_size; i++) {
+        int j = map(i);
+        if (j != i) {
+            amplitudes[j] = old_amplitudes[i];
+        }
+    }
+}
+
 // Quantum Ripple-Carry Adder (Cuccaro Adder)
 // Computes: |a⟩|b⟩|0⟩ → |a⟩|a+b⟩|carry⟩
 // Where:
@@ -17,10 +62,12 @@ private:
     int b_start;
     int carry_start;
     int num_bits;
+    ArithmeticMode mode;
     
 public:
-    QuantumAdder(int a_start, int b_start, int carry_start, int num_bits)
-        : a_start(a_start), b_start(b_start), carry_start(carry_start), num_bits(num_bits) {
+    QuantumAdder(int a_start, int b_start, int carry_start, int num_bits,
+                 ArithmeticMode mode = GATE_LEVEL)
+        : a_start(a_start), b_start(b_start), carry_start(carry_start), num_bits(num_bits), mode(mode) {
         
         if (a_start < 0 || b_start < 0 || carry_start < 0) {
             throw std::invalid_argument("Qubit positions must be non-negative");
@@ -40,6 +87,34 @@ public:
             throw std::invalid_argument("Register exceeds number of qubits in state");
         }
 
+        if (mode == EMULATED) {
+            applyIndexPermutation(state, [this](int index) { return mapIndex(index); });
+            return;
+        }
+
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    // Net effect of decompose() on one basis index, bit by bit:
+    // carry_out ^= MAJ(a_i, b_i, carry_in), then b_i ^= a_i ^ carry_in
+    int mapIndex(int index) const {
+        for (int i = 0; i < num_bits; i++) {
+            int a = (index >> (a_start + i)) & 1;
+            int b = (index >> (b_start + i)) & 1;
+            int carry_in = (index >> (carry_start + i)) & 1;
+            int majority = (a & b) ^ (a & carry_in) ^ (b & carry_in);
+            index ^= majority << (carry_start + i + 1);
+            index ^= (a ^ carry_in) << (b_start + i);
+        }
+        return index;
+    }
+
+    // Gate sequence of the ripple-carry addition
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+
         // Perform ripple-carry addition
         for (int i = 0; i < num_bits; i++) {
             int a_qubit = a_start + i;
@@ -52,28 +127,31 @@ public:
             
             
             // Step 1: Compute a_i ∧ b_i
-            ToffoliGate maj1(a_qubit, b_qubit, carry_out);
-            maj1.apply(state);
+            gates.push_back(std::make_shared<ToffoliGate>(a_qubit, b_qubit, carry_out));
             
             // Step 2: Add a_i ∧ carry_in
-            ToffoliGate maj2(a_qubit, carry_in, carry_out);
-            maj2.apply(state);
+            gates.push_back(std::make_shared<ToffoliGate>(a_qubit, carry_in, carry_out));
             
             // Step 3: Add b_i ∧ carry_in
-            ToffoliGate maj3(b_qubit, carry_in, carry_out);
-            maj3.apply(state);
+            gates.push_back(std::make_shared<ToffoliGate>(b_qubit, carry_in, carry_out));
             
             // Compute sum bit: b_i = a_i ⊕ b_i ⊕ carry_in
             // First: b_i = a_i ⊕ b_i
-            CNOTGate sum1(a_qubit, b_qubit);
-            sum1.apply(state);
+            gates.push_back(std::make_shared<CNOTGate>(a_qubit, b_qubit));
             
             // Then: b_i = b_i ⊕ carry_in
-            CNOTGate sum2(carry_in, b_qubit);
-            sum2.apply(state);            
+            gates.push_back(std::make_shared<CNOTGate>(carry_in, b_qubit));
         }
+        return gates;
     }
     
+    std::string describe() const override {
+        return describeGate("ADD", {a_start, b_start, carry_start, num_bits});
+    }
+
+    void setMode(ArithmeticMode new_mode) { mode = new_mode; }
+    ArithmeticMode getMode() const { return mode; }
+
     int getAStart() const { return a_start; }
     int getBStart() const { return b_start; }
     int getCarryStart() const { return carry_start; }
@@ -95,10 +173,13 @@ private:
     int result_start;
     int num_bits;
     int ancilla_start;
+    ArithmeticMode mode;
     
 public:
-    QuantumComparator(int a_start, int b_start, int result_start, int num_bits, int ancilla_start = -1)
-        : a_start(a_start), b_start(b_start), result_start(result_start), num_bits(num_bits), ancilla_start(ancilla_start){
+    QuantumComparator(int a_start, int b_start, int result_start, int num_bits, int ancilla_start = -1,
+                      ArithmeticMode mode = GATE_LEVEL)
+        : a_start(a_start), b_start(b_start), result_start(result_start), num_bits(num_bits), ancilla_start(ancilla_start),
+          mode(mode) {
         if (a_start < 0 || b_start < 0 || result_start < 0) {
             throw std::invalid_argument("Qubit positions must be non-negative");
         }
@@ -117,8 +198,35 @@ public:
             throw std::invalid_argument("Register exceeds number of qubits in state");
         }
 
-        XGate init_result(result_start);
-        init_result.apply(state);
+        if (mode == EMULATED) {
+            applyIndexPermutation(state, [this](int index) { return mapIndex(index); });
+            return;
+        }
+
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    // Net effect of decompose() on one basis index, bit by bit:
+    // flip result_0, then b_i ^= a_i ^ 1 and result_{i+1} ^= b_i ∧ result_i
+    int mapIndex(int index) const {
+        index ^= 1 << result_start;
+        for (int i = 0; i < num_bits; i++) {
+            int a = (index >> (a_start + i)) & 1;
+            index ^= (a ^ 1) << (b_start + i);
+            int b = (index >> (b_start + i)) & 1;
+            int previous = (index >> (result_start + i)) & 1;
+            index ^= (b & previous) << (result_start + i + 1);
+        }
+        return index;
+    }
+
+    // Gate sequence of the equality comparison
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+
+        gates.push_back(std::make_shared<XGate>(result_start));
         
         // Compare from most significant bit to least significant bit
         for (int i = 0; i < num_bits; i++) {
@@ -128,21 +236,26 @@ public:
 
             // Step 1: XOR the bits to check if they're different
             // If a_i = b_i, then b_qubit becomes |0⟩, otherwise |1⟩
-            CNOTGate xor_ab(a_qubit, b_qubit);
-            xor_ab.apply(state);
+            gates.push_back(std::make_shared<CNOTGate>(a_qubit, b_qubit));
 
-            XGate invert_b(b_qubit);
-            invert_b.apply(state);
+            gates.push_back(std::make_shared<XGate>(b_qubit));
             
             // Step 2: Use Toffoli gate to propagate inequality detection
             // If current bits are different (b_qubit = |1⟩) AND all more significant
             // bits were equal (result_qubit - 1 = |1⟩), then mark this position
             // This ensures we detect the first (most significant) difference
-            ToffoliGate check_not_equal(b_qubit, result_qubit - 1, result_qubit);
-            check_not_equal.apply(state);
+            gates.push_back(std::make_shared<ToffoliGate>(b_qubit, result_qubit - 1, result_qubit));
         }
+        return gates;
     }
     
+    std::string describe() const override {
+        return describeGate("CMP", {a_start, b_start, result_start, num_bits});
+    }
+
+    void setMode(ArithmeticMode new_mode) { mode = new_mode; }
+    ArithmeticMode getMode() const { return mode; }
+
     int getAStart() const { return a_start; }
     int getBStart() const { return b_start; }
     int getResultStart() const { return result_start; }
@@ -150,4 +263,605 @@ public:
     int getAncillaStart() const { return ancilla_start; }
 };
 
+// Phase factors e^(2πi·m/2^num_bits) for m in [0, 2^num_bits)
+// Shared lookup table for the fused Fourier-space adders below
+inline std::vector<Complex> fourierPhaseTable(int num_bits) {
+    int size = 1 << num_bits;
+    std::vector<Complex> phases(size);
+    for (int m = 0; m < size; m++) {
+        double angle = 2.0 * M_PI * m / size;
+        phases[m] = Complex(std::cos(angle), std::sin(angle));
+    }
+    return phases;
+}
+
+// Quantum Fourier Transform on a contiguous register
+// Computes: |x⟩ → 1/√N Σ_k e^(2πi·xk/N) |k⟩ with N = 2^num_bits and
+// qubit 'start' as the least significant bit. Built from Hadamards,
+// controlled phase rotations and a final bit-reversal of SWAPs; the inverse
+// applies the same gates in reverse order with negated angles.
+class QFTGate : public QuantumGate {
+private:
+    int start;
+    int num_bits;
+    bool inverse;
+
+public:
+    QFTGate(int start, int num_bits, bool inverse = false)
+        : start(start), num_bits(num_bits), inverse(inverse) {
+        if (start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0) {
+            throw std::invalid_argument("Number of bits must be positive");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        if (start + num_bits > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+
+        // Most significant qubit first: H, then rotations controlled by the lower qubits
+        for (int j = num_bits - 1; j >= 0; j--) {
+            gates.push_back(std::make_shared<HadamardGate>(start + j));
+            for (int k = j - 1; k >= 0; k--) {
+                double angle = M_PI * std::ldexp(1.0, -(j - k));
+                gates.push_back(std::make_shared<ControlledPhaseShiftGate>(start + k, start + j, angle));
+            }
+        }
+
+        // Reverse the bit order so the output is in standard order
+        for (int i = 0; i < num_bits / 2; i++) {
+            gates.push_back(std::make_shared<SWAPGate>(start + i, start + num_bits - 1 - i));
+        }
+
+        if (!inverse) {
+            return gates;
+        }
+
+        // Inverse: reverse the sequence and conjugate the rotations
+        std::vector<std::shared_ptr<QuantumGate>> inverse_gates;
+        for (auto it = gates.rbegin(); it != gates.rend(); ++it) {
+            auto rotation = std::dynamic_pointer_cast<ControlledPhaseShiftGate>(*it);
+            if (rotation) {
+                inverse_gates.push_back(std::make_shared<ControlledPhaseShiftGate>(
+                    rotation->getControls(), rotation->getTarget(), -rotation->getPhase()));
+            } else {
+                inverse_gates.push_back(*it);
+            }
+        }
+        return inverse_gates;
+    }
+
+    std::string describe() const override {
+        return describeGate(inverse ? "IQFT" : "QFT", {start, num_bits});
+    }
+
+    int getStart() const { return start; }
+    int getNumBits() const { return num_bits; }
+    bool isInverse() const { return inverse; }
+};
+
+// Fourier-space register adder (Draper φADD)
+// With the target register in the Fourier basis (after QFTGate), multiplying
+// |k⟩ by e^(±2πi·a·k/N) adds (or subtracts) the addend register value a.
+// decompose() gives the controlled-rotation circuit; apply() executes the
+// whole phase layer as one diagonal sweep using a table of N phases.
+class FourierAdderGate : public QuantumGate {
+private:
+    int addend_start;
+    int target_start;
+    int num_bits;
+    bool subtract;
+
+public:
+    FourierAdderGate(int addend_start, int target_start, int num_bits, bool subtract = false)
+        : addend_start(addend_start), target_start(target_start), num_bits(num_bits), subtract(subtract) {
+        if (addend_start < 0 || target_start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0) {
+            throw std::invalid_argument("Number of bits must be positive");
+        }
+        if (addend_start < target_start + num_bits && target_start < addend_start + num_bits) {
+            throw std::invalid_argument("Addend and target registers must not overlap");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int total_qubits = state.getNumQubits();
+        if (addend_start + num_bits > total_qubits || target_start + num_bits > total_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        std::vector<Complex> phases = fourierPhaseTable(num_bits);
+        uint64_t mask = (uint64_t(1) << num_bits) - 1;
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            uint64_t addend = (uint64_t(i) >> addend_start) & mask;
+            uint64_t k = (uint64_t(i) >> target_start) & mask;
+            uint64_t m = (addend * k) & mask;
+            if (subtract) {
+                m = (mask + 1 - m) & mask;
+            }
+            if (m != 0) {
+                amplitudes[i] = complexMul(amplitudes[i], phases[m]);
+            }
+        }
+    }
+
+    // One rotation per bit pair (a_j, k_l) with j + l < num_bits
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        double sign = subtract ? -1.0 : 1.0;
+        for (int l = 0; l < num_bits; l++) {
+            for (int j = 0; j + l < num_bits; j++) {
+                double angle = sign * 2.0 * M_PI * std::ldexp(1.0, -(num_bits - j - l));
+                gates.push_back(std::make_shared<ControlledPhaseShiftGate>(addend_start + j, target_start + l, angle));
+            }
+        }
+        return gates;
+    }
+
+    std::string describe() const override {
+        return describeGate("FADD", {addend_start, target_start, num_bits, subtract});
+    }
+
+    int getAddendStart() const { return addend_start; }
+    int getTargetStart() const { return target_start; }
+    int getNumBits() const { return num_bits; }
+    bool isSubtract() const { return subtract; }
+};
+
+// Fourier-space constant adder (Draper φADD(c)), optionally controlled
+// With the target register in the Fourier basis, multiplying |k⟩ by
+// e^(2πi·c·k/N) adds the classical constant c (mod N). Negative constants
+// subtract. The phase is only applied when all control qubits are |1⟩.
+// Like FourierAdderGate, apply() is a single diagonal sweep.
+class FourierConstantAdderGate : public QuantumGate {
+private:
+    int target_start;
+    int num_bits;
+    uint64_t constant;  // Reduced into [0, 2^num_bits)
+    std::vector<int> control_qubits;
+
+public:
+    FourierConstantAdderGate(int target_start, int num_bits, int64_t constant,
+                             const std::vector<int>& controls = {})
+        : target_start(target_start), num_bits(num_bits), control_qubits(controls) {
+        if (target_start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0 || num_bits > 62) {
+            throw std::invalid_argument("Number of bits must be between 1 and 62");
+        }
+        for (int control : controls) {
+            if (control < 0) {
+                throw std::invalid_argument("Control qubits must be non-negative");
+            }
+            if (control >= target_start && control < target_start + num_bits) {
+                throw std::invalid_argument("Control qubits must be outside the target register");
+            }
+        }
+        int64_t modulus = int64_t(1) << num_bits;
+        this->constant = uint64_t(((constant % modulus) + modulus) % modulus);
+    }
+
+    void apply(QuantumState& state) override {
+        int total_qubits = state.getNumQubits();
+        if (target_start + num_bits > total_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        int control_mask = 0;
+        for (int control : control_qubits) {
+            if (control >= total_qubits) {
+                throw std::invalid_argument("Control qubit exceeds number of qubits in state");
+            }
+            control_mask |= 1 << control;
+        }
+        if (constant == 0) {
+            return;
+        }
+
+        // Phase for each target value k: e^(2πi·c·k/N)
+        std::vector<Complex> phases = fourierPhaseTable(num_bits);
+        uint64_t mask = (uint64_t(1) << num_bits) - 1;
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            if ((i & control_mask) != control_mask) {
+                continue;
+            }
+            uint64_t k = (uint64_t(i) >> target_start) & mask;
+            uint64_t m = (constant * k) & mask;
+            if (m != 0) {
+                amplitudes[i] = complexMul(amplitudes[i], phases[m]);
+            }
+        }
+    }
+
+    // One (controlled) phase rotation per target qubit
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        uint64_t mask = (uint64_t(1) << num_bits) - 1;
+        for (int l = 0; l < num_bits; l++) {
+            uint64_t m = (constant << l) & mask;
+            if (m == 0) {
+                continue;
+            }
+            double angle = 2.0 * M_PI * double(m) / double(mask + 1);
+            if (control_qubits.empty()) {
+                gates.push_back(std::make_shared<PhaseShiftGate>(target_start + l, angle));
+            } else {
+                gates.push_back(std::make_shared<ControlledPhaseShiftGate>(control_qubits, target_start + l, angle));
+            }
+        }
+        return gates;
+    }
+
+    std::string describe() const override {
+        std::vector<DescribeParam> params = {target_start, num_bits, constant};
+        params.insert(params.end(), control_qubits.begin(), control_qubits.end());
+        return describeGate("FCADD", params);
+    }
+
+    int getTargetStart() const { return target_start; }
+    int getNumBits() const { return num_bits; }
+    uint64_t getConstant() const { return constant; }
+    const std::vector<int>& getControls() const { return control_qubits; }
+};
+
+// Draper QFT Adder
+// Computes: |a⟩|b⟩ → |a⟩|a+b mod 2^n⟩ without carry or ancilla qubits
+// (QuantumAdder needs num_bits + 1 carries, i.e. 2^(num_bits+1) times the
+// state size). Gate sequence: QFT(b), φADD(a), inverse QFT(b).
+// Where:
+// - a_start: starting qubit for first addend
+// - b_start: starting qubit for second addend (also stores result)
+// - num_bits: number of bits in each number
+class DraperAdder : public QuantumGate {
+private:
+    int a_start;
+    int b_start;
+    int num_bits;
+    ArithmeticMode mode;
+
+public:
+    DraperAdder(int a_start, int b_start, int num_bits, ArithmeticMode mode = GATE_LEVEL)
+        : a_start(a_start), b_start(b_start), num_bits(num_bits), mode(mode) {
+        if (a_start < 0 || b_start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0) {
+            throw std::invalid_argument("Number of bits must be positive");
+        }
+        if (a_start < b_start + num_bits && b_start < a_start + num_bits) {
+            throw std::invalid_argument("Addend registers must not overlap");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int total_qubits = state.getNumQubits();
+        if (a_start + num_bits > total_qubits || b_start + num_bits > total_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        if (mode == EMULATED) {
+            applyIndexPermutation(state, [this](int index) { return mapIndex(index); });
+            return;
+        }
+
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    // Net effect of decompose() on one basis index: b ← (a + b) mod 2^n
+    int mapIndex(int index) const {
+        int mask = (1 << num_bits) - 1;
+        int a = (index >> a_start) & mask;
+        int b = (index >> b_start) & mask;
+        return (index & ~(mask << b_start)) | (((a + b) & mask) << b_start);
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        return {
+            std::make_shared<QFTGate>(b_start, num_bits),
+            std::make_shared<FourierAdderGate>(a_start, b_start, num_bits),
+            std::make_shared<QFTGate>(b_start, num_bits, true)
+        };
+    }
+
+    std::string describe() const override {
+        return describeGate("DADD", {a_start, b_start, num_bits});
+    }
+
+    void setMode(ArithmeticMode new_mode) { mode = new_mode; }
+    ArithmeticMode getMode() const { return mode; }
+
+    int getAStart() const { return a_start; }
+    int getBStart() const { return b_start; }
+    int getNumBits() const { return num_bits; }
+};
+
+// Constant Adder (Draper)
+// Computes: |b⟩ → |b+c mod 2^n⟩ for a classical constant c, in place and
+// without ancillas. Gate sequence: QFT(b), φADD(c), inverse QFT(b).
+// Negative constants subtract.
+class ConstantAdder : public QuantumGate {
+private:
+    int b_start;
+    int num_bits;
+    int64_t constant;
+    ArithmeticMode mode;
+
+public:
+    ConstantAdder(int b_start, int num_bits, int64_t constant, ArithmeticMode mode = GATE_LEVEL)
+        : b_start(b_start), num_bits(num_bits), mode(mode) {
+        if (b_start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0 || num_bits > 30) {
+            throw std::invalid_argument("Number of bits must be between 1 and 30");
+        }
+        int64_t modulus = int64_t(1) << num_bits;
+        this->constant = ((constant % modulus) + modulus) % modulus;
+    }
+
+    void apply(QuantumState& state) override {
+        if (b_start + num_bits > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        if (mode == EMULATED) {
+            applyIndexPermutation(state, [this](int index) { return mapIndex(index); });
+            return;
+        }
+
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    // Net effect of decompose() on one basis index: b ← (b + c) mod 2^n
+    int mapIndex(int index) const {
+        int mask = (1 << num_bits) - 1;
+        int b = (index >> b_start) & mask;
+        return (index & ~(mask << b_start)) | (int((b + constant) & mask) << b_start);
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        return {
+            std::make_shared<QFTGate>(b_start, num_bits),
+            std::make_shared<FourierConstantAdderGate>(b_start, num_bits, constant),
+            std::make_shared<QFTGate>(b_start, num_bits, true)
+        };
+    }
+
+    std::string describe() const override {
+        return describeGate("CADD", {b_start, num_bits, constant});
+    }
+
+    void setMode(ArithmeticMode new_mode) { mode = new_mode; }
+    ArithmeticMode getMode() const { return mode; }
+
+    int getBStart() const { return b_start; }
+    int getNumBits() const { return num_bits; }
+    int64_t getConstant() const { return constant; }
+};
+
+// Multiplicative inverse of 'value' modulo 'modulus' (extended Euclid)
+// Throws if gcd(value, modulus) ≠ 1
+inline uint64_t modularInverse(uint64_t value, uint64_t modulus) {
+    int64_t old_r = int64_t(value % modulus), r = int64_t(modulus);
+    int64_t old_s = 1, s = 0;
+    while (r != 0) {
+        int64_t quotient = old_r / r;
+        int64_t next_r = old_r - quotient * r;
+        old_r = r;
+        r = next_r;
+        int64_t next_s = old_s - quotient * s;
+        old_s = s;
+        s = next_s;
+    }
+    if (old_r != 1) {
+        throw std::invalid_argument("Value has no inverse: gcd with modulus is not 1");
+    }
+    int64_t m = int64_t(modulus);
+    return uint64_t(((old_s % m) + m) % m);
+}
+
+// Beauregard Controlled Modular Multiplier (2n+3 qubits)
+// Computes: |c⟩|x⟩|0⟩|0⟩ → |c⟩|a·x mod N⟩|0⟩|0⟩ if c = |1⟩, for x < N
+// Where:
+// - control: control qubit c
+// - x_start: n-qubit register x, multiplied in place
+// - b_start: (n+1)-qubit work register, |0⟩ before and after
+// - ancilla: one work qubit, |0⟩ before and after
+// - num_bits: n, with modulus N < 2^n and gcd(a, N) = 1
+// decompose() produces the real circuit: CMULT(a) built from doubly
+// controlled Fourier-space modular adders, a controlled SWAP of x and b
+// made of CNOT/Toffoli gates, and CMULT(a⁻¹ mod N) run as a subtraction to
+// uncompute b. EMULATED mode applies each modular addition as one
+// permutation pass on the computational basis instead of going through
+// the Fourier basis, and the swap as one ControlledRegisterSwapGate pass.
+// Inputs outside the valid subspace (x ≥ N, nonzero work qubits) are not
+// guaranteed to agree.
+class BeauregardModMult : public QuantumGate {
+private:
+    int control_qubit;
+    int x_start;
+    int b_start;
+    int ancilla_qubit;
+    int num_bits;
+    uint64_t multiplier;
+    uint64_t modulus;
+    uint64_t inverse_multiplier;
+    ArithmeticMode mode;
+
+    // Doubly controlled φADD(constant)MOD(N) on the Fourier-basis register b
+    void appendModularAdd(std::vector<std::shared_ptr<QuantumGate>>& gates, int64_t constant,
+                          const std::vector<int>& controls) const {
+        int width = num_bits + 1;
+        int msb = b_start + num_bits;
+        int64_t n = int64_t(modulus);
+
+        // b + c - N: the sign bit tells whether b + c < N
+        gates.push_back(std::make_shared<FourierConstantAdderGate>(b_start, width, constant, controls));
+        gates.push_back(std::make_shared<FourierConstantAdderGate>(b_start, width, -n));
+        gates.push_back(std::make_shared<QFTGate>(b_start, width, true));
+        gates.push_back(std::make_shared<CNOTGate>(msb, ancilla_qubit));
+        gates.push_back(std::make_shared<QFTGate>(b_start, width));
+        gates.push_back(std::make_shared<FourierConstantAdderGate>(b_start, width, n, std::vector<int>{ancilla_qubit}));
+
+        // Uncompute the ancilla: subtract c again and read the sign bit
+        gates.push_back(std::make_shared<FourierConstantAdderGate>(b_start, width, -constant, controls));
+        gates.push_back(std::make_shared<QFTGate>(b_start, width, true));
+        gates.push_back(std::make_shared<XGate>(msb));
+        gates.push_back(std::make_shared<CNOTGate>(msb, ancilla_qubit));
+        gates.push_back(std::make_shared<XGate>(msb));
+        gates.push_back(std::make_shared<QFTGate>(b_start, width));
+        gates.push_back(std::make_shared<FourierConstantAdderGate>(b_start, width, constant, controls));
+    }
+
+    // CMULT(factor)MOD(N): b ← b + factor·x mod N, controlled by c
+    void appendControlledMultiplyAdd(std::vector<std::shared_ptr<QuantumGate>>& gates, uint64_t factor) const {
+        gates.push_back(std::make_shared<QFTGate>(b_start, num_bits + 1));
+        uint64_t term = factor % modulus;
+        for (int i = 0; i < num_bits; i++) {
+            appendModularAdd(gates, int64_t(term), {control_qubit, x_start + i});
+            term = (term * 2) % modulus;
+        }
+        gates.push_back(std::make_shared<QFTGate>(b_start, num_bits + 1, true));
+    }
+
+    // Net effect of one doubly controlled modular addition on a basis index
+    int mapModularAdd(int index, uint64_t constant, int x_qubit) const {
+        if (((index >> control_qubit) & 1) == 0 || ((index >> x_qubit) & 1) == 0) {
+            return index;
+        }
+        int mask = (1 << (num_bits + 1)) - 1;
+        uint64_t b = (index >> b_start) & mask;
+        if (b >= modulus) {
+            return index;
+        }
+        b = (b + constant) % modulus;
+        return (index & ~(mask << b_start)) | int(b << b_start);
+    }
+
+public:
+    BeauregardModMult(int control, int x_start, int b_start, int ancilla, int num_bits,
+                      uint64_t multiplier, uint64_t modulus, ArithmeticMode mode = GATE_LEVEL)
+        : control_qubit(control), x_start(x_start), b_start(b_start), ancilla_qubit(ancilla),
+          num_bits(num_bits), multiplier(multiplier), modulus(modulus), inverse_multiplier(0), mode(mode) {
+        if (control < 0 || x_start < 0 || b_start < 0 || ancilla < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (num_bits <= 0 || 2 * num_bits + 3 > 31) {
+            throw std::invalid_argument("Number of bits must be between 1 and 14");
+        }
+        if (modulus < 2 || modulus >= (uint64_t(1) << num_bits)) {
+            throw std::invalid_argument("Modulus must satisfy 2 <= N < 2^num_bits");
+        }
+
+        // Registers must be pairwise disjoint
+        std::vector<std::pair<int, int>> ranges = {
+            {control, 1}, {x_start, num_bits}, {b_start, num_bits + 1}, {ancilla, 1}};
+        for (size_t i = 0; i < ranges.size(); i++) {
+            for (size_t j = i + 1; j < ranges.size(); j++) {
+                if (ranges[i].first < ranges[j].first + ranges[j].second &&
+                    ranges[j].first < ranges[i].first + ranges[i].second) {
+                    throw std::invalid_argument("Registers must not overlap");
+                }
+            }
+        }
+
+        this->multiplier = multiplier % modulus;
+        inverse_multiplier = modularInverse(multiplier, modulus);
+    }
+
+    void apply(QuantumState& state) override {
+        int total_qubits = state.getNumQubits();
+        if (control_qubit >= total_qubits || ancilla_qubit >= total_qubits ||
+            x_start + num_bits > total_qubits || b_start + num_bits + 1 > total_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        if (mode == EMULATED) {
+            // b ← a·x mod N, one pass per controlled modular addition
+            uint64_t term = multiplier;
+            for (int i = 0; i < num_bits; i++) {
+                int x_qubit = x_start + i;
+                applyIndexPermutation(state, [this, term, x_qubit](int index) {
+                    return mapModularAdd(index, term, x_qubit);
+                });
+                term = (term * 2) % modulus;
+            }
+
+            ControlledRegisterSwapGate(control_qubit, x_start, b_start, num_bits).apply(state);
+
+            // b ← b - a⁻¹·x mod N, which clears b on the valid subspace
+            term = (modulus - inverse_multiplier) % modulus;
+            for (int i = 0; i < num_bits; i++) {
+                int x_qubit = x_start + i;
+                applyIndexPermutation(state, [this, term, x_qubit](int index) {
+                    return mapModularAdd(index, term, x_qubit);
+                });
+                term = (term * 2) % modulus;
+            }
+            return;
+        }
+
+        for (const auto& gate : decompose()) {
+            gate->apply(state);
+        }
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+
+        // b ← a·x mod N
+        appendControlledMultiplyAdd(gates, multiplier);
+
+        // Controlled SWAP of x and b, each qubit as CNOT·Toffoli·CNOT
+        std::vector<std::shared_ptr<QuantumGate>> swap_gates =
+            ControlledRegisterSwapGate(control_qubit, x_start, b_start, num_bits).decompose();
+        gates.insert(gates.end(), swap_gates.begin(), swap_gates.end());
+
+        // b ← b - a⁻¹·(a·x) mod N = 0, adding the negated inverse
+        appendControlledMultiplyAdd(gates, (modulus - inverse_multiplier) % modulus);
+        return gates;
+    }
+
+    std::string describe() const override {
+        return describeGate("BMODMULT", {control_qubit, x_start, b_start,
+                                         ancilla_qubit, num_bits,
+                                         multiplier, modulus});
+    }
+
+    void setMode(ArithmeticMode new_mode) { mode = new_mode; }
+    ArithmeticMode getMode() const { return mode; }
+
+    int getControl() const { return control_qubit; }
+    int getXStart() const { return x_start; }
+    int getBStart() const { return b_start; }
+    int getAncilla() const { return ancilla_qubit; }
+    int getNumBits() const { return num_bits; }
+    uint64_t getMultiplier() const { return multiplier; }
+    uint64_t getModulus() const { return modulus; }
+};
+
 #endif // QUANTUM_ARITHMETIC_H
\ No newline at end of file
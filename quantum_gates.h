@@ -2,16 +2,69 @@
 #define QUANTUM_GATES_H
 
 #include "quantum_state.h"
+#include "complex_math.h"
 #include <cmath>
 #include <vector>
+#include <string>
+#include <sstream>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 
 // Abstract base class for quantum gates
 class QuantumGate {
 public:
     virtual void apply(QuantumState& state) = 0;
+
+    // Canonical text description of the gate and all of its parameters,
+    // e.g. "H(3)" or "CMODMULT(0,4,4,7,15)". Two gates with the same
+    // description must act identically on every state; this is what
+    // circuit fingerprints are built from. An empty string means the
+    // gate cannot be described and must never be cached.
+    virtual std::string describe() const { return ""; }
+
+    // Sub-gates this gate is built from, in application order
+    // Primitive gates return an empty list; composite gates (circuits,
+    // arithmetic blocks) return the gates their apply() executes, or an
+    // equivalent sequence if apply() runs a fused kernel. This lets tools
+    // such as the JIT see through them
+    virtual std::vector<std::shared_ptr<QuantumGate>> decompose() const { return {}; }
+
     virtual ~QuantumGate() = default;
 };
 
+// One describe() parameter as text: integers print exactly (multipliers,
+// moduli and masks may exceed the 53 bits a double holds), reals with 17
+// significant digits so that distinct values never share a description
+class DescribeParam {
+private:
+    std::string text;
+
+public:
+    template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    DescribeParam(T value) : text(std::to_string(value)) {}
+
+    DescribeParam(double value) {
+        std::ostringstream stream;
+        stream.precision(17);
+        stream << value;
+        text = stream.str();
+    }
+
+    const std::string& getText() const { return text; }
+};
+
+// Helper for describe(): "NAME(p1,p2,...)"
+inline std::string describeGate(const std::string& name, const std::vector<DescribeParam>& params) {
+    std::string text = name + "(";
+    for (size_t i = 0; i < params.size(); i++) {
+        if (i > 0) text += ",";
+        text += params[i].getText();
+    }
+    return text + ")";
+}
+
 // Hadamard Gate
 // Creates superposition by transforming: H|0⟩ = (|0⟩ + |1⟩)/√2, H|1⟩ = (|0⟩ - |1⟩)/√2
 class HadamardGate : public QuantumGate {
@@ -35,12 +88,9 @@ public:
             throw std::invalid_argument("Target qubit exceeds number of qubits in state");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes(state_size);
-
-        // Apply Hadamard gate to target qubit
+        // Apply Hadamard gate to target qubit in place
         // For each basis state, we need to find its pair (differing only in target qubit)
+        Complex* amplitudes = state.data();
         int mask = 1 << target_qubit;
 
         for (int i = 0; i < state_size; i++) {
@@ -48,21 +98,20 @@ public:
 
             // Only process each pair once (when i has 0 at target bit)
             if ((i & mask) == 0) {
-                Complex amp0 = old_amplitudes[i];
-                Complex amp1 = old_amplitudes[j];
+                Complex amp0 = amplitudes[i];
+                Complex amp1 = amplitudes[j];
 
                 // Apply Hadamard transformation
                 // H|0⟩ = (|0⟩ + |1⟩)/√2
                 // H|1⟩ = (|0⟩ - |1⟩)/√2
-                new_amplitudes[i] = (amp0 + amp1) * INV_SQRT2;
-                new_amplitudes[j] = (amp0 - amp1) * INV_SQRT2;
+                amplitudes[i] = (amp0 + amp1) * INV_SQRT2;
+                amplitudes[j] = (amp0 - amp1) * INV_SQRT2;
             }
         }
+    }
 
-        // Update the quantum state with new amplitudes
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("H", {target_qubit});
     }
 
     int getTarget() const { return target_qubit; }
@@ -95,29 +144,25 @@ public:
             throw std::invalid_argument("Control or target qubit exceeds number of qubits in state");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes = old_amplitudes;
-
-        // Apply CNOT gate
+        // Apply CNOT gate in place
         // For each basis state where control qubit is 1, flip the target qubit
+        Complex* amplitudes = state.data();
         int control_mask = 1 << control_qubit;
         int target_mask = 1 << target_qubit;
 
         for (int i = 0; i < state_size; i++) {
-            // Check if control qubit is 1
-            if ((i & control_mask) != 0) {
-                // Flip target qubit to get the destination index
+            // Check if control qubit is 1 (visit each pair once, from target = 0)
+            if ((i & control_mask) != 0 && (i & target_mask) == 0) {
+                // Flip target qubit to get the paired index
                 int j = i ^ target_mask;
                 // Swap amplitudes (CNOT is its own inverse)
-                new_amplitudes[j] = old_amplitudes[i];
+                std::swap(amplitudes[i], amplitudes[j]);
             }
         }
+    }
 
-        // Update the quantum state with new amplitudes
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("CNOT", {control_qubit, target_qubit});
     }
 
     int getControl() const { return control_qubit; }
@@ -150,33 +195,25 @@ public:
             throw std::invalid_argument("Qubit exceeds number of qubits in state");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes = old_amplitudes;
-
-        // Apply SWAP gate
+        // Apply SWAP gate in place
         // For each basis state where qubit1 and qubit2 have different values,
         // swap with the state where those two bits are flipped
+        Complex* amplitudes = state.data();
         int mask1 = 1 << qubit1;
         int mask2 = 1 << qubit2;
 
         for (int i = 0; i < state_size; i++) {
-            // Check if the two qubits have different values
-            bool bit1 = (i & mask1) != 0;
-            bool bit2 = (i & mask2) != 0;
-
-            if (bit1 != bit2) {
-                // Swap: flip both bits to get the paired state
+            // Visit each pair once: qubit1 = 1 and qubit2 = 0
+            if ((i & mask1) != 0 && (i & mask2) == 0) {
+                // Flip both bits to get the paired state
                 int j = i ^ mask1 ^ mask2;
-                // Swap amplitudes
-                new_amplitudes[i] = old_amplitudes[j];
+                std::swap(amplitudes[i], amplitudes[j]);
             }
         }
+    }
 
-        // Update the quantum state with new amplitudes
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("SWAP", {qubit1, qubit2});
     }
 
     int getQubit1() const { return qubit1; }
@@ -214,30 +251,25 @@ public:
             throw std::invalid_argument("Qubit exceeds number of qubits in state");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes = old_amplitudes;
-
-        // Apply Toffoli gate
+        // Apply Toffoli gate in place
         // For each basis state where both control qubits are 1, flip the target qubit
-        int control1_mask = 1 << control1_qubit;
-        int control2_mask = 1 << control2_qubit;
+        Complex* amplitudes = state.data();
+        int control_mask = (1 << control1_qubit) | (1 << control2_qubit);
         int target_mask = 1 << target_qubit;
 
         for (int i = 0; i < state_size; i++) {
-            // Check if both control qubits are 1
-            if (((i & control1_mask) != 0) && ((i & control2_mask) != 0)) {
-                // Flip target qubit to get the destination index
+            // Check if both control qubits are 1 (visit each pair once, from target = 0)
+            if ((i & control_mask) == control_mask && (i & target_mask) == 0) {
+                // Flip target qubit to get the paired index
                 int j = i ^ target_mask;
                 // Swap amplitudes (Toffoli is its own inverse)
-                new_amplitudes[j] = old_amplitudes[i];
+                std::swap(amplitudes[i], amplitudes[j]);
             }
         }
+    }
 
-        // Update the quantum state with new amplitudes
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("TOFFOLI", {control1_qubit, control2_qubit, target_qubit});
     }
 
     int getControl1() const { return control1_qubit; }
@@ -245,6 +277,164 @@ public:
     int getTarget() const { return target_qubit; }
 };
 
+// Exchange two equal-width contiguous registers in every basis index with
+// all 'control_mask' bits set, in place. Each pair of indices is visited
+// once, from the index whose swapped image is larger. Double-buffered
+// states gather instead; the swap is its own inverse.
+inline void swapRegisters(QuantumState& state, int control_mask, int a_start, int b_start, int count) {
+    int state_size = state.getStateSize();
+    Complex* amplitudes = state.data();
+    int field_mask = (1 << count) - 1;
+    int clear_mask = ~((field_mask << a_start) | (field_mask << b_start));
+
+    if (state.isDoubleBuffered()) {
+        gatherPermutation(state, [=](int j) {
+            if ((j & control_mask) != control_mask) {
+                return j;
+            }
+            int a = (j >> a_start) & field_mask;
+            int b = (j >> b_start) & field_mask;
+            return (j & clear_mask) | (b << a_start) | (a << b_start);
+        });
+        return;
+    }
+
+    QS_PARALLEL_FOR
+    for (int i = 0; i < state_size; i++) {
+        if ((i & control_mask) != control_mask) {
+            continue;
+        }
+        int a = (i >> a_start) & field_mask;
+        int b = (i >> b_start) & field_mask;
+        int j = (i & clear_mask) | (b << a_start) | (a << b_start);
+        if (j > i) {
+            std::swap(amplitudes[i], amplitudes[j]);
+        }
+    }
+}
+
+// Inverse of a map on the values of a 'bits'-wide register, as a table:
+// inverse[map(y)] = y. Returns false if the map is not a bijection (a
+// multiplier not coprime to the modulus); callers then use their in-place
+// kernel, which handles that case the way it always has
+template <typename Map>
+bool invertRegisterMap(int bits, Map map, std::vector<int>& inverse) {
+    size_t size = size_t(1) << bits;
+    inverse.assign(size, -1);
+    for (size_t y = 0; y < size; y++) {
+        uint64_t image = map(uint64_t(y));
+        if (image >= size || inverse[image] >= 0) {
+            return false;
+        }
+        inverse[image] = int(y);
+    }
+    return true;
+}
+
+// Register SWAP Gate
+// Exchanges two equal-width registers: |a⟩|b⟩ → |b⟩|a⟩
+// Generalizes SWAPGate to registers; one pass instead of 'count' swaps
+class RegisterSwapGate : public QuantumGate {
+private:
+    int a_start;
+    int b_start;
+    int count;
+
+public:
+    RegisterSwapGate(int a_start, int b_start, int count)
+        : a_start(a_start), b_start(b_start), count(count) {
+        if (a_start < 0 || b_start < 0 || count <= 0) {
+            throw std::invalid_argument("Invalid qubit parameters");
+        }
+        if (a_start < b_start + count && b_start < a_start + count) {
+            throw std::invalid_argument("Registers must not overlap");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        if (a_start + count > num_qubits || b_start + count > num_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        swapRegisters(state, 0, a_start, b_start, count);
+    }
+
+    // Equivalent qubit-by-qubit SWAPs
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        for (int i = 0; i < count; i++) {
+            gates.push_back(std::make_shared<SWAPGate>(a_start + i, b_start + i));
+        }
+        return gates;
+    }
+
+    std::string describe() const override {
+        return describeGate("RSWAP", {a_start, b_start, count});
+    }
+
+    int getAStart() const { return a_start; }
+    int getBStart() const { return b_start; }
+    int getCount() const { return count; }
+};
+
+// Controlled Register SWAP Gate (multi-qubit Fredkin)
+// Exchanges two equal-width registers if the control qubit is |1⟩
+// One in-place pass instead of 'count' Fredkin gates (3·count sweeps as
+// CNOT·Toffoli·CNOT)
+class ControlledRegisterSwapGate : public QuantumGate {
+private:
+    int control_qubit;
+    int a_start;
+    int b_start;
+    int count;
+
+public:
+    ControlledRegisterSwapGate(int control, int a_start, int b_start, int count)
+        : control_qubit(control), a_start(a_start), b_start(b_start), count(count) {
+        if (control < 0 || a_start < 0 || b_start < 0 || count <= 0) {
+            throw std::invalid_argument("Invalid qubit parameters");
+        }
+        if (a_start < b_start + count && b_start < a_start + count) {
+            throw std::invalid_argument("Registers must not overlap");
+        }
+        if ((control >= a_start && control < a_start + count) ||
+            (control >= b_start && control < b_start + count)) {
+            throw std::invalid_argument("Control qubit must not be in a swapped register");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        if (control_qubit >= num_qubits) {
+            throw std::invalid_argument("Control qubit exceeds number of qubits");
+        }
+        if (a_start + count > num_qubits || b_start + count > num_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        swapRegisters(state, 1 << control_qubit, a_start, b_start, count);
+    }
+
+    // Equivalent Fredkin gates, each as CNOT·Toffoli·CNOT
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        for (int i = 0; i < count; i++) {
+            gates.push_back(std::make_shared<CNOTGate>(b_start + i, a_start + i));
+            gates.push_back(std::make_shared<ToffoliGate>(control_qubit, a_start + i, b_start + i));
+            gates.push_back(std::make_shared<CNOTGate>(b_start + i, a_start + i));
+        }
+        return gates;
+    }
+
+    std::string describe() const override {
+        return describeGate("CRSWAP", {control_qubit, a_start, b_start, count});
+    }
+
+    int getControl() const { return control_qubit; }
+    int getAStart() const { return a_start; }
+    int getBStart() const { return b_start; }
+    int getCount() const { return count; }
+};
+
 // Phase Shift Gate (Rz gate)
 // Applies a phase shift to the |1⟩ state: |0⟩ → |0⟩, |1⟩ → e^(iθ)|1⟩
 // Can be used to implement:
@@ -277,19 +467,89 @@ public:
         }
 
         // Apply phase shift to target qubit
-        // For basis states where target qubit is 1, multiply amplitude by e^(iθ)
+        // Basis states with the target qubit set form runs of 2^target
+        // consecutive indices; each run is multiplied by e^(iθ) in one
+        // branch-free pass, the other amplitudes remain unchanged
+        Complex* amplitudes = state.data();
+        int run = 1 << target_qubit;
+
+        for (int start = run; start < state_size; start += 2 * run) {
+            complexScale(amplitudes + start, run, phase_factor);
+        }
+    }
+
+    std::string describe() const override {
+        return describeGate("PHASE", {target_qubit, phase_angle});
+    }
+
+    int getTarget() const { return target_qubit; }
+    double getPhase() const { return phase_angle; }
+};
+
+// Controlled Phase Shift Gate
+// Multiplies the amplitude by e^(iθ) when every control qubit and the target
+// qubit are |1⟩, and leaves all other basis states unchanged. The gate is
+// diagonal and symmetric in its qubits; with one control it is the rotation
+// used by the QFT and by Fourier-space adders.
+class ControlledPhaseShiftGate : public QuantumGate {
+private:
+    std::vector<int> control_qubits;
+    int target_qubit;
+    double phase_angle;
+    Complex phase_factor;
+
+public:
+    ControlledPhaseShiftGate(int control, int target, double angle)
+        : ControlledPhaseShiftGate(std::vector<int>{control}, target, angle) {}
+
+    ControlledPhaseShiftGate(const std::vector<int>& controls, int target, double angle)
+        : control_qubits(controls), target_qubit(target), phase_angle(angle) {
+        if (target < 0) {
+            throw std::invalid_argument("Target qubit must be non-negative");
+        }
+        for (int control : controls) {
+            if (control < 0) {
+                throw std::invalid_argument("Control qubits must be non-negative");
+            }
+            if (control == target) {
+                throw std::invalid_argument("Control and target qubits must be different");
+            }
+        }
+        phase_factor = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        int state_size = state.getStateSize();
+
         int mask = 1 << target_qubit;
+        for (int control : control_qubits) {
+            if (control >= num_qubits) {
+                throw std::invalid_argument("Control qubit exceeds number of qubits in state");
+            }
+            mask |= 1 << control;
+        }
+        if (target_qubit >= num_qubits) {
+            throw std::invalid_argument("Target qubit exceeds number of qubits in state");
+        }
 
+        // Only basis states with all of the gate's qubits set pick up the phase
+        Complex* amplitudes = state.data();
         for (int i = 0; i < state_size; i++) {
-            // Check if target qubit is 1
-            if ((i & mask) != 0) {
-                Complex current_amp = state.getAmplitude(i);
-                state.setAmplitude(i, current_amp * phase_factor);
+            if ((i & mask) == mask) {
+                amplitudes[i] = complexMul(amplitudes[i], phase_factor);
             }
-            // If target qubit is 0, amplitude remains unchanged
         }
     }
 
+    std::string describe() const override {
+        std::vector<DescribeParam> params(control_qubits.begin(), control_qubits.end());
+        params.push_back(target_qubit);
+        params.push_back(phase_angle);
+        return describeGate("CPHASE", params);
+    }
+
+    const std::vector<int>& getControls() const { return control_qubits; }
     int getTarget() const { return target_qubit; }
     double getPhase() const { return phase_angle; }
 };
@@ -316,34 +576,46 @@ public:
             throw std::invalid_argument("Target qubit exceeds number of qubits in state");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes = old_amplitudes;
-
         // Apply X gate by swapping amplitudes of basis states that differ only in target qubit
+        Complex* amplitudes = state.data();
         int mask = 1 << target_qubit;
 
         for (int i = 0; i < state_size; i++) {
             // Only process each pair once (when i has 0 at target bit)
             if ((i & mask) == 0) {
                 int j = i ^ mask; // Flip the target qubit bit
-                // Swap amplitudes
-                new_amplitudes[i] = old_amplitudes[j];
-                new_amplitudes[j] = old_amplitudes[i];
+                std::swap(amplitudes[i], amplitudes[j]);
             }
         }
+    }
 
-        // Update the quantum state with new amplitudes
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("X", {target_qubit});
     }
 
     int getTarget() const { return target_qubit; }
 };
 
+// True if y ↦ multiplier·y mod modulus permutes the values of a
+// 'count'-bit register (values ≥ modulus stay put): the multiplier must be
+// coprime to the modulus, and the modulus must fit in the register
+inline bool isModMultPermutation(uint64_t multiplier, uint64_t modulus, int count) {
+    if (count < 64 && modulus > (uint64_t(1) << count)) {
+        return false;
+    }
+    uint64_t a = multiplier % modulus;
+    uint64_t b = modulus;
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a == 1;
+}
+
 // Controlled Modular Multiplication Gate
 // Performs: |control, y⟩ → |control, (multiplier * y) mod N⟩ if control is |1⟩
+// Register values y >= N are left unchanged, so the map is a permutation
 // NOTE: This gate is ONLY reversible/unitary when gcd(multiplier, N) = 1
 // The input validation ensures this condition is met
 class ControlledModMultGate : public QuantumGate {
@@ -398,18 +670,37 @@ public:
             throw std::invalid_argument("Target register exceeds number of qubits");
         }
 
-        // Get current amplitudes
-        const std::vector<Complex>& old_amplitudes = state.getAmplitudes();
-        std::vector<Complex> new_amplitudes = old_amplitudes;
-
         int control_mask = 1 << control_qubit;
 
+        // Double-buffered: gather every index from its preimage
+        std::vector<int> source;
+        auto multiply = [this](uint64_t y) { return y < modulus ? (multiplier * y) % modulus : y; };
+        if (state.isDoubleBuffered() && invertRegisterMap(target_qubits_count, multiply, source)) {
+            int field = int(((1ULL << target_qubits_count) - 1) << target_qubits_start);
+            int start = target_qubits_start;
+            const int* table = source.data();
+            gatherPermutation(state, [=](int j) {
+                if ((j & control_mask) == 0) {
+                    return j;
+                }
+                return (j & ~field) | (table[(j & field) >> start] << start);
+            });
+            return;
+        }
+
+        // Snapshot the current amplitudes; only moved entries are written back
+        Complex* amplitudes = state.data();
+        std::vector<Complex> old_amplitudes(amplitudes, amplitudes + state_size);
+
         // Apply controlled modular multiplication
         for (int i = 0; i < state_size; i++) {
             // Only act if control qubit is |1⟩
             if ((i & control_mask) != 0) {
                 // Extract target register value
                 uint64_t y = extractTarget(i);
+                if (y >= modulus) {
+                    continue;  // Outside the modular range: identity
+                }
 
                 // Apply modular multiplication
                 uint64_t new_y = (multiplier * y) % modulus;
@@ -418,14 +709,16 @@ public:
                 int j = replaceTarget(i, new_y);
 
                 // Move amplitude
-                new_amplitudes[j] = old_amplitudes[i];
+                if (j != i) {
+                    amplitudes[j] = old_amplitudes[i];
+                }
             }
         }
+    }
 
-        // Update state
-        for (int i = 0; i < state_size; i++) {
-            state.setAmplitude(i, new_amplitudes[i]);
-        }
+    std::string describe() const override {
+        return describeGate("CMODMULT", {control_qubit, target_qubits_start, target_qubits_count,
+                                         multiplier, modulus});
     }
 
     int getControl() const { return control_qubit; }
@@ -435,4 +728,120 @@ public:
     uint64_t getModulus() const { return modulus; }
 };
 
+// Windowed (Table-Lookup) Modular Multiplication Gate
+// Performs: |k, y⟩ → |k, (multipliers[k] * y) mod N⟩ where k is the value
+// of a window of control qubits. With multipliers[k] = a^(k·2^j) mod N one
+// gate replaces the ControlledModMultGates of exponent bits j..j+w-1, so a
+// w-qubit window costs one sweep instead of w.
+// Register values y >= N are left unchanged, so the map is a permutation
+// NOTE: Every multiplier must be coprime to N for the gate to be unitary
+class LookupModMultGate : public QuantumGate {
+private:
+    int window_start;
+    int window_size;
+    int target_qubits_start;
+    int target_qubits_count;
+    std::vector<uint64_t> multipliers;  // One entry per window value k
+    uint64_t modulus;
+
+public:
+    LookupModMultGate(int window_start, int window_size, int target_start, int target_count,
+                      const std::vector<uint64_t>& multipliers, uint64_t mod)
+        : window_start(window_start), window_size(window_size), target_qubits_start(target_start),
+          target_qubits_count(target_count), multipliers(multipliers), modulus(mod) {
+
+        if (window_start < 0 || window_size <= 0 || window_size > 16 || target_start < 0 || target_count <= 0) {
+            throw std::invalid_argument("Invalid qubit parameters");
+        }
+        if (multipliers.size() != (size_t(1) << window_size)) {
+            throw std::invalid_argument("Need one multiplier per window value (2^window_size)");
+        }
+        if (mod == 0 || std::find(multipliers.begin(), multipliers.end(), uint64_t(0)) != multipliers.end()) {
+            throw std::invalid_argument("Multipliers and modulus must be positive");
+        }
+        if (window_start < target_start + target_count && target_start < window_start + window_size) {
+            throw std::invalid_argument("Control window must not overlap target register");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        int state_size = state.getStateSize();
+
+        // Validate
+        if (window_start + window_size > num_qubits) {
+            throw std::invalid_argument("Control window exceeds number of qubits");
+        }
+        if (target_qubits_start + target_qubits_count > num_qubits) {
+            throw std::invalid_argument("Target register exceeds number of qubits");
+        }
+
+        int window_mask = (1 << window_size) - 1;
+        uint64_t target_mask = (1ULL << target_qubits_count) - 1;
+        int target_field = int(target_mask << target_qubits_start);
+
+        // Double-buffered: gather through one inverse table per window value,
+        // stored back to back (entry (k << target_count) | y)
+        if (state.isDoubleBuffered()) {
+            std::vector<int> sources;
+            std::vector<int> inverse;
+            bool bijective = true;
+            for (size_t k = 0; k < multipliers.size() && bijective; k++) {
+                uint64_t multiplier = multipliers[k];
+                bijective = invertRegisterMap(target_qubits_count, [&](uint64_t y) {
+                    return y < modulus ? (multiplier * y) % modulus : y;
+                }, inverse);
+                sources.insert(sources.end(), inverse.begin(), inverse.end());
+            }
+            if (bijective) {
+                int start = target_qubits_start;
+                int count = target_qubits_count;
+                int window = window_start;
+                const int* table = sources.data();
+                gatherPermutation(state, [=](int j) {
+                    int y = (j & target_field) >> start;
+                    int k = (j >> window) & window_mask;
+                    return (j & ~target_field) | (table[(k << count) | y] << start);
+                });
+                return;
+            }
+        }
+
+        // Snapshot the current amplitudes; only moved entries are written back
+        Complex* amplitudes = state.data();
+        std::vector<Complex> old_amplitudes(amplitudes, amplitudes + state_size);
+
+        // Each index selects its multiplier from the table by window value
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            uint64_t multiplier = multipliers[(i >> window_start) & window_mask];
+            uint64_t y = (uint64_t(i) >> target_qubits_start) & target_mask;
+            if (multiplier == 1 || y >= modulus) {
+                continue;  // Identity for this index
+            }
+            int j = (i & ~target_field) | int(((multiplier * y) % modulus) << target_qubits_start);
+            if (j != i) {
+                amplitudes[j] = old_amplitudes[i];
+            }
+        }
+    }
+
+    std::string describe() const override {
+        std::string description = describeGate("LMODMULT", {window_start, window_size,
+                                                            target_qubits_start, target_qubits_count});
+        description += ":";
+        for (uint64_t multiplier : multipliers) {
+            description += std::to_string(multiplier) + ",";
+        }
+        return description + std::to_string(modulus);
+    }
+
+    int getWindowStart() const { return window_start; }
+    int getWindowSize() const { return window_size; }
+    int getTargetStart() const { return target_qubits_start; }
+    int getTargetCount() const { return target_qubits_count; }
+    const std::vector<uint64_t>& getMultipliers() const { return multipliers; }
+    uint64_t getModulus() const { return modulus; }
+};
+
 #endif // QUANTUM_GATES_H
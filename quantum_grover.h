@@ -0,0 +1,167 @@
+#ifndef QUANTUM_GROVER_H
+#define QUANTUM_GROVER_H
+
+#include "quantum_oracle.h"
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+// Reflection about the mean within every block of a register
+// For each block (all indices sharing the bits outside [start, start+count))
+// computes mean = Σ s(x)·a_x / 2^count and sets a_x ← 2·mean - s(x)·a_x.
+// 'signs' holds s(x) = ±1 per register value, or is null for s = 1. With
+// signs from an oracle this is one fused Grover iteration: two passes over
+// the state (reduction, update) instead of an oracle sweep plus ~4n+1
+// sweeps of H, X and multi-controlled Z.
+inline void reflectAboutBlockMean(QuantumState& state, int start, int count, const double* signs) {
+    int state_size = state.getStateSize();
+    Complex* amplitudes = state.data();
+    int length = 1 << count;
+    int fibers = state_size >> count;
+
+    // Register spans the whole state: one block, parallel reduction
+    if (fibers == 1) {
+        double sum_real = 0.0;
+        double sum_imag = 0.0;
+        QS_PARALLEL_SUM(sum_real, sum_imag)
+        for (int x = 0; x < length; x++) {
+            double sign = signs ? signs[x] : 1.0;
+            sum_real += sign * amplitudes[x].real();
+            sum_imag += sign * amplitudes[x].imag();
+        }
+        Complex twice_mean(2.0 * sum_real / length, 2.0 * sum_imag / length);
+
+        QS_PARALLEL_FOR
+        for (int x = 0; x < length; x++) {
+            double sign = signs ? signs[x] : 1.0;
+            amplitudes[x] = twice_mean - sign * amplitudes[x];
+        }
+        return;
+    }
+
+    // Several blocks: each is reduced and updated independently
+    int low_mask = (1 << start) - 1;
+    QS_PARALLEL_FOR
+    for (int fiber = 0; fiber < fibers; fiber++) {
+        int base = (fiber & low_mask) | ((fiber & ~low_mask) << count);
+        Complex sum(0.0, 0.0);
+        for (int x = 0; x < length; x++) {
+            double sign = signs ? signs[x] : 1.0;
+            sum += sign * amplitudes[base | (x << start)];
+        }
+        Complex twice_mean = 2.0 * sum / double(length);
+        for (int x = 0; x < length; x++) {
+            double sign = signs ? signs[x] : 1.0;
+            Complex& amplitude = amplitudes[base | (x << start)];
+            amplitude = twice_mean - sign * amplitude;
+        }
+    }
+}
+
+// Grover Diffusion Gate
+// Inversion about the mean, 2|s⟩⟨s| - I with |s⟩ the uniform superposition
+// of the register, applied as one reduction and one update pass. If the
+// register does not cover the whole state, each block of the other qubits
+// is reflected about its own mean. The usual H-X-MCZ-X-H chain implements
+// the same operator up to a global phase of -1.
+class DiffusionGate : public QuantumGate {
+private:
+    int start;
+    int count;
+
+public:
+    DiffusionGate(int start, int count) : start(start), count(count) {
+        if (start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (count <= 0) {
+            throw std::invalid_argument("Number of qubits must be positive");
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        if (start + count > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        reflectAboutBlockMean(state, start, count, nullptr);
+    }
+
+    std::string describe() const override {
+        return describeGate("DIFFUSE", {start, count});
+    }
+
+    int getStart() const { return start; }
+    int getCount() const { return count; }
+};
+
+// Optimal number of Grover iterations for 'marked_count' of 2^count values
+inline int groverIterations(int count, uint64_t marked_count) {
+    if (marked_count == 0) {
+        return 0;
+    }
+    double ratio = std::ldexp(1.0, count) / double(marked_count);
+    return int(std::floor(M_PI / 4.0 * std::sqrt(ratio)));
+}
+
+// Grover Search
+// Runs 'iterations' Grover iterations on a register: phase oracle marking
+// the values where 'marked' is true, then diffusion. Each iteration is
+// fused into one reflectAboutBlockMean call with the oracle signs
+// tabulated once. decompose() lists the unfused PhaseOracleGate and
+// DiffusionGate pairs. The register is expected to start in a uniform
+// superposition (e.g. after Hadamards).
+template <typename Predicate>
+class GroverSearch : public QuantumGate {
+private:
+    static_assert(std::is_same<typename std::decay<decltype(std::declval<const Predicate&>()(uint64_t(0)))>::type,
+                               bool>::value,
+                  "Grover predicate must return bool");
+
+    int start;
+    int count;
+    Predicate marked;
+    int iterations;
+    std::vector<double> signs;  // -1 for marked register values, +1 otherwise
+
+public:
+    GroverSearch(int start, int count, Predicate marked, int iterations)
+        : start(start), count(count), marked(marked), iterations(iterations) {
+        if (start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (count <= 0 || count > 30) {
+            throw std::invalid_argument("Register size must be between 1 and 30");
+        }
+        if (iterations < 0) {
+            throw std::invalid_argument("Iteration count must be non-negative");
+        }
+        signs.resize(size_t(1) << count);
+        for (size_t x = 0; x < signs.size(); x++) {
+            signs[x] = marked(uint64_t(x)) ? -1.0 : 1.0;
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        if (start + count > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        for (int k = 0; k < iterations; k++) {
+            reflectAboutBlockMean(state, start, count, signs.data());
+        }
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> decompose() const override {
+        std::vector<std::shared_ptr<QuantumGate>> gates;
+        for (int k = 0; k < iterations; k++) {
+            gates.push_back(std::make_shared<PhaseOracleGate<Predicate>>(start, count, marked));
+            gates.push_back(std::make_shared<DiffusionGate>(start, count));
+        }
+        return gates;
+    }
+
+    int getStart() const { return start; }
+    int getCount() const { return count; }
+    int getIterations() const { return iterations; }
+};
+
+#endif // QUANTUM_GROVER_H
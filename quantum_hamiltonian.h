@@ -0,0 +1,288 @@
+#ifndef QUANTUM_HAMILTONIAN_H
+#define QUANTUM_HAMILTONIAN_H
+
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include "circuit.h"
+#include <string>
+#include <vector>
+
+// Parity of the set bits of a basis index: 0 or 1
+inline int bitParity(int value) {
+    unsigned bits = static_cast<unsigned>(value);
+    bits ^= bits >> 16;
+    bits ^= bits >> 8;
+    bits ^= bits >> 4;
+    bits ^= bits >> 2;
+    bits ^= bits >> 1;
+    return int(bits & 1);
+}
+
+// Multi-qubit Pauli operator stored as bit masks
+// X and Y set the qubit's bit in x_mask, Z and Y in z_mask, so that
+// P|x⟩ = i^(#Y) · (-1)^popcount(x & z_mask) · |x ⊕ x_mask⟩
+struct PauliString {
+    int x_mask;
+    int z_mask;
+
+    PauliString() : x_mask(0), z_mask(0) {}
+
+    // Letter i of 'paulis' (I, X, Y or Z) acts on qubits[i]
+    // e.g. PauliString("XZY", {0, 2, 5}) is X₀Z₂Y₅
+    PauliString(const std::string& paulis, const std::vector<int>& qubits) : x_mask(0), z_mask(0) {
+        if (paulis.size() != qubits.size()) {
+            throw std::invalid_argument("Need one qubit per Pauli letter");
+        }
+        for (size_t i = 0; i < paulis.size(); i++) {
+            int qubit = qubits[i];
+            if (qubit < 0 || qubit >= 31) {
+                throw std::invalid_argument("Pauli qubit out of range");
+            }
+            int bit = 1 << qubit;
+            if (((x_mask | z_mask) & bit) != 0) {
+                throw std::invalid_argument("Pauli string names a qubit twice");
+            }
+            switch (paulis[i]) {
+                case 'I': break;
+                case 'X': x_mask |= bit; break;
+                case 'Y': x_mask |= bit; z_mask |= bit; break;
+                case 'Z': z_mask |= bit; break;
+                default:
+                    throw std::invalid_argument("Pauli letters must be I, X, Y or Z");
+            }
+        }
+    }
+
+    int yCount() const {
+        int count = 0;
+        for (int y_mask = x_mask & z_mask; y_mask != 0; y_mask &= y_mask - 1) {
+            count++;
+        }
+        return count;
+    }
+    bool isDiagonal() const { return x_mask == 0; }
+
+    // Two Pauli strings commute iff they anticommute on an even number of qubits
+    bool commutesWith(const PauliString& other) const {
+        return bitParity((x_mask & other.z_mask) ^ (z_mask & other.x_mask)) == 0;
+    }
+
+    // Highest qubit the string acts on, or -1 for the identity
+    int highestQubit() const {
+        int support = x_mask | z_mask;
+        int qubit = -1;
+        while (support != 0) {
+            support >>= 1;
+            qubit++;
+        }
+        return qubit;
+    }
+
+    // Canonical text form, e.g. "X0Z2Y5"
+    std::string toString() const {
+        std::string text;
+        for (int q = 0; q <= highestQubit(); q++) {
+            bool x = (x_mask >> q) & 1;
+            bool z = (z_mask >> q) & 1;
+            if (x || z) {
+                text += (x && z) ? 'Y' : (x ? 'X' : 'Z');
+                text += std::to_string(q);
+            }
+        }
+        return text.empty() ? "I" : text;
+    }
+};
+
+// One term c·P of a Hamiltonian H = Σ c_j P_j
+struct PauliTerm {
+    double coefficient;
+    PauliString pauli;
+};
+
+// Pauli Rotation Gate: exp(-iθP) = cos θ·I - i sin θ·P
+// Applied directly in one in-place pass instead of basis changes, a CNOT
+// ladder, a phase and the reverse (about 4k+1 sweeps for weight k).
+// Indices are paired by x_mask; each pair is a 2x2 rotation whose signs
+// come from the parity of the index under z_mask. Diagonal strings
+// (only I and Z) scale every amplitude by e^(∓iθ).
+class PauliRotationGate : public QuantumGate {
+private:
+    PauliString pauli;
+    double theta;
+
+public:
+    PauliRotationGate(const PauliString& pauli, double theta) : pauli(pauli), theta(theta) {}
+
+    PauliRotationGate(const std::string& paulis, const std::vector<int>& qubits, double theta)
+        : pauli(paulis, qubits), theta(theta) {}
+
+    void apply(QuantumState& state) override {
+        if (pauli.highestQubit() >= state.getNumQubits()) {
+            throw std::invalid_argument("Pauli string exceeds number of qubits in state");
+        }
+
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+        double c = std::cos(theta);
+        double s = std::sin(theta);
+        int x_mask = pauli.x_mask;
+        int z_mask = pauli.z_mask;
+
+        if (pauli.isDiagonal()) {
+            // exp(-iθ·(±1)) depending on the Z parity of the index
+            Complex even_phase(c, -s);
+            Complex odd_phase(c, s);
+            QS_PARALLEL_FOR
+            for (int i = 0; i < state_size; i++) {
+                amplitudes[i] = complexMul(amplitudes[i], bitParity(i & z_mask) ? odd_phase : even_phase);
+            }
+            return;
+        }
+
+        // -i·sin θ·i^(#Y), the factor in front of the signed partner amplitude
+        static const Complex I_POWERS[4] = {Complex(1, 0), Complex(0, 1), Complex(-1, 0), Complex(0, -1)};
+        Complex coupling = complexMul(Complex(0, -s), I_POWERS[pauli.yCount() & 3]);
+
+        // Visit each pair once, from the index with the top x_mask bit clear
+        int pivot = 1 << pauli.highestQubit();
+        while ((pivot & x_mask) == 0) {
+            pivot >>= 1;
+        }
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            if ((i & pivot) != 0) {
+                continue;
+            }
+            int j = i ^ x_mask;
+            Complex a_i = amplitudes[i];
+            Complex a_j = amplitudes[j];
+            // (P a)_i = phase(j)·a_j with phase(j) = i^(#Y)·(-1)^popcount(j & z)
+            double sign_i = bitParity(i & z_mask) ? -1.0 : 1.0;
+            double sign_j = bitParity(j & z_mask) ? -1.0 : 1.0;
+            amplitudes[i] = complexFma(c * a_i, coupling, sign_j * a_j);
+            amplitudes[j] = complexFma(c * a_j, coupling, sign_i * a_i);
+        }
+    }
+
+    std::string describe() const override {
+        return describeGate("PAULIROT", {pauli.x_mask, pauli.z_mask, theta});
+    }
+
+    const PauliString& getPauli() const { return pauli; }
+    double getTheta() const { return theta; }
+};
+
+// Diagonal Pauli Evolution Gate: exp(-i·t·Σ c_j P_j) for Z-only strings
+// All terms commute and are diagonal, so they are fused into one pass:
+// each amplitude picks up exp(-i·t·Σ ±c_j) with signs from Z parities
+class DiagonalPauliEvolutionGate : public QuantumGate {
+private:
+    std::vector<PauliTerm> terms;
+    double time;
+
+public:
+    DiagonalPauliEvolutionGate(const std::vector<PauliTerm>& terms, double time) : terms(terms), time(time) {
+        for (const PauliTerm& term : terms) {
+            if (!term.pauli.isDiagonal()) {
+                throw std::invalid_argument("Diagonal evolution needs Z-only Pauli strings");
+            }
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        for (const PauliTerm& term : terms) {
+            if (term.pauli.highestQubit() >= state.getNumQubits()) {
+                throw std::invalid_argument("Pauli string exceeds number of qubits in state");
+            }
+        }
+
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+        int num_terms = int(terms.size());
+        const PauliTerm* term_data = terms.data();
+
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            double energy = 0.0;
+            for (int k = 0; k < num_terms; k++) {
+                double sign = bitParity(i & term_data[k].pauli.z_mask) ? -1.0 : 1.0;
+                energy += sign * term_data[k].coefficient;
+            }
+            double angle = -time * energy;
+            amplitudes[i] = complexMul(amplitudes[i], Complex(std::cos(angle), std::sin(angle)));
+        }
+    }
+
+    std::string describe() const override {
+        std::vector<DescribeParam> params = {time};
+        for (const PauliTerm& term : terms) {
+            params.push_back(term.coefficient);
+            params.push_back(term.pauli.z_mask);
+        }
+        return describeGate("ZEVOLVE", params);
+    }
+
+    size_t getTermCount() const { return terms.size(); }
+};
+
+// Split terms into groups of mutually commuting Pauli strings (greedy, in
+// order). Within a group the exponentials commute, so their product is
+// exact and the order inside a group does not matter.
+inline std::vector<std::vector<PauliTerm>> groupCommutingTerms(const std::vector<PauliTerm>& terms) {
+    std::vector<std::vector<PauliTerm>> groups;
+    for (const PauliTerm& term : terms) {
+        bool placed = false;
+        for (auto& group : groups) {
+            bool commutes = true;
+            for (const PauliTerm& member : group) {
+                if (!term.pauli.commutesWith(member.pauli)) {
+                    commutes = false;
+                    break;
+                }
+            }
+            if (commutes) {
+                group.push_back(term);
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            groups.push_back({term});
+        }
+    }
+    return groups;
+}
+
+// First-order Trotter circuit for exp(-i·H·time), H = Σ c_j P_j
+// Each of the 'steps' slices applies the commuting groups in turn. Within a
+// group, all diagonal terms are fused into one DiagonalPauliEvolutionGate
+// and every other term becomes one PauliRotationGate.
+inline Circuit trotterCircuit(const std::vector<PauliTerm>& terms, double time, int steps) {
+    if (steps <= 0) {
+        throw std::invalid_argument("Trotter step count must be positive");
+    }
+    double dt = time / steps;
+
+    Circuit slice;
+    for (const auto& group : groupCommutingTerms(terms)) {
+        std::vector<PauliTerm> diagonal;
+        for (const PauliTerm& term : group) {
+            if (term.pauli.isDiagonal()) {
+                diagonal.push_back(term);
+            } else {
+                slice.add<PauliRotationGate>(term.pauli, term.coefficient * dt);
+            }
+        }
+        if (!diagonal.empty()) {
+            slice.add<DiagonalPauliEvolutionGate>(diagonal, dt);
+        }
+    }
+
+    Circuit circuit;
+    for (int step = 0; step < steps; step++) {
+        circuit.append(slice);
+    }
+    return circuit;
+}
+
+#endif // QUANTUM_HAMILTONIAN_H
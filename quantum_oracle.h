@@ -0,0 +1,344 @@
+#ifndef QUANTUM_ORACLE_H
+#define QUANTUM_ORACLE_H
+
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Classical function given as a lookup table: f(x) = values[x]
+// Usable wherever an oracle takes a callable; gates built on a table can
+// also describe() themselves, so they take part in prefix caching
+struct FunctionTable {
+    std::vector<uint64_t> values;
+
+    uint64_t operator()(uint64_t x) const { return values[x]; }
+};
+
+// How an oracle combines f(x) with the target register
+// ORACLE_XOR: |x⟩|y⟩ → |x⟩|y ⊕ f(x)⟩ (self-inverse)
+// ORACLE_ADD: |x⟩|y⟩ → |x⟩|y + f(x) mod 2^m⟩
+enum OracleMode {
+    ORACLE_XOR,
+    ORACLE_ADD
+};
+
+// Classical-Function Oracle Gate
+// Applies a classical function of the input register to the target
+// register, with f(x) taken modulo 2^target_count. 'function' is any
+// callable uint64_t → uint64_t; being a template parameter it is inlined
+// into the kernel. Both kernels work in place without copying the state:
+// an XOR oracle is a set of disjoint amplitude swaps, and an ADD oracle
+// rotates each target-register fiber by f(x).
+// Where:
+// - input_start, input_count: register x read by the function
+// - target_start, target_count: register y that receives f(x)
+template <typename Function>
+class OracleGate : public QuantumGate {
+private:
+    int input_start;
+    int input_count;
+    int target_start;
+    int target_count;
+    Function function;
+    OracleMode oracle_mode;
+
+    void applyXor(QuantumState& state) const {
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+        uint64_t input_mask = (uint64_t(1) << input_count) - 1;
+        uint64_t target_mask = (uint64_t(1) << target_count) - 1;
+
+        // i and i ^ (f(x) << target_start) form a pair; swap it once
+        QS_PARALLEL_FOR
+        for (int i = 0; i < state_size; i++) {
+            uint64_t x = (uint64_t(i) >> input_start) & input_mask;
+            int flip = int((function(x) & target_mask) << target_start);
+            int j = i ^ flip;
+            if (j > i) {
+                std::swap(amplitudes[i], amplitudes[j]);
+            }
+        }
+    }
+
+    void applyAdd(QuantumState& state) const {
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+        uint64_t input_mask = (uint64_t(1) << input_count) - 1;
+        int length = 1 << target_count;
+        int low_mask = (1 << target_start) - 1;
+        int fibers = state_size >> target_count;
+
+        // Each fiber (all indices sharing the non-target bits) is rotated
+        // by f(x) in place: gcd(f, length) cycles of length / gcd each
+        QS_PARALLEL_FOR
+        for (int fiber = 0; fiber < fibers; fiber++) {
+            int base = (fiber & low_mask) | ((fiber & ~low_mask) << target_count);
+            uint64_t x = (uint64_t(base) >> input_start) & input_mask;
+            int shift = int(function(x) & uint64_t(length - 1));
+            if (shift == 0) {
+                continue;
+            }
+
+            int cycles = gcdInt(shift, length);
+            for (int start = 0; start < cycles; start++) {
+                Complex carried = amplitudes[base | (start << target_start)];
+                int position = start;
+                do {
+                    position = (position + shift) & (length - 1);
+                    std::swap(carried, amplitudes[base | (position << target_start)]);
+                } while (position != start);
+            }
+        }
+    }
+
+    static int gcdInt(int a, int b) {
+        while (b != 0) {
+            int temp = b;
+            b = a % b;
+            a = temp;
+        }
+        return a;
+    }
+
+public:
+    OracleGate(int input_start, int input_count, int target_start, int target_count,
+               Function function, OracleMode oracle_mode = ORACLE_XOR)
+        : input_start(input_start), input_count(input_count), target_start(target_start),
+          target_count(target_count), function(function), oracle_mode(oracle_mode) {
+        if (input_start < 0 || target_start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (input_count <= 0 || target_count <= 0) {
+            throw std::invalid_argument("Register sizes must be positive");
+        }
+        if (input_start < target_start + target_count && target_start < input_start + input_count) {
+            throw std::invalid_argument("Input and target registers must not overlap");
+        }
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            if (function.values.size() != (size_t(1) << input_count)) {
+                throw std::invalid_argument("Function table needs 2^input_count entries");
+            }
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        int num_qubits = state.getNumQubits();
+        if (input_start + input_count > num_qubits || target_start + target_count > num_qubits) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+        if (oracle_mode == ORACLE_XOR) {
+            applyXor(state);
+        } else {
+            applyAdd(state);
+        }
+    }
+
+    // Only table-driven oracles can be described; callables are opaque
+    std::string describe() const override {
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            std::string description = describeGate(oracle_mode == ORACLE_XOR ? "XORACLE" : "AORACLE",
+                {input_start, input_count, target_start, target_count});
+            description += ":";
+            for (size_t i = 0; i < function.values.size(); i++) {
+                description += (i > 0 ? "," : "") + std::to_string(function.values[i]);
+            }
+            return description;
+        }
+        return "";
+    }
+
+    int getInputStart() const { return input_start; }
+    int getInputCount() const { return input_count; }
+    int getTargetStart() const { return target_start; }
+    int getTargetCount() const { return target_count; }
+    OracleMode getOracleMode() const { return oracle_mode; }
+};
+
+// In-Place Permutation Oracle Gate
+// Applies a bijection g of one register: |x⟩ → |g(x)⟩
+// g is evaluated once per register value and split into cycles (checking
+// that it is a bijection); every fiber of the state is then permuted by
+// following those cycles, so the state is never copied.
+template <typename Function>
+class PermutationOracleGate : public QuantumGate {
+private:
+    int start;
+    int count;
+    Function function;
+    std::vector<int> cycle_elements;  // All non-trivial cycles, concatenated
+    std::vector<int> cycle_ends;      // End offset of each cycle
+
+public:
+    PermutationOracleGate(int start, int count, Function function)
+        : start(start), count(count), function(function) {
+        if (start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (count <= 0 || count > 30) {
+            throw std::invalid_argument("Register size must be between 1 and 30");
+        }
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            if (function.values.size() != (size_t(1) << count)) {
+                throw std::invalid_argument("Function table needs 2^count entries");
+            }
+        }
+
+        // Tabulate g and reject anything that is not a bijection
+        int length = 1 << count;
+        std::vector<int> image(length);
+        std::vector<bool> hit(length, false);
+        for (int x = 0; x < length; x++) {
+            uint64_t y = function(uint64_t(x));
+            if (y >= uint64_t(length) || hit[y]) {
+                throw std::invalid_argument("Permutation oracle function must be a bijection on the register");
+            }
+            hit[y] = true;
+            image[x] = int(y);
+        }
+
+        // Cycle decomposition, following x → g(x) with a visited bitmap
+        std::vector<bool> visited(length, false);
+        for (int x = 0; x < length; x++) {
+            if (visited[x] || image[x] == x) {
+                continue;
+            }
+            for (int y = x; !visited[y]; y = image[y]) {
+                visited[y] = true;
+                cycle_elements.push_back(y);
+            }
+            cycle_ends.push_back(int(cycle_elements.size()));
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        if (start + count > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        Complex* amplitudes = state.data();
+        int low_mask = (1 << start) - 1;
+        int fibers = state.getStateSize() >> count;
+        int num_cycles = int(cycle_ends.size());
+
+        QS_PARALLEL_FOR
+        for (int fiber = 0; fiber < fibers; fiber++) {
+            int base = (fiber & low_mask) | ((fiber & ~low_mask) << count);
+            int begin = 0;
+            for (int c = 0; c < num_cycles; c++) {
+                // Amplitude at x moves to g(x), the next element of the cycle
+                int end = cycle_ends[c];
+                Complex carried = amplitudes[base | (cycle_elements[begin] << start)];
+                for (int k = begin + 1; k < end; k++) {
+                    std::swap(carried, amplitudes[base | (cycle_elements[k] << start)]);
+                }
+                amplitudes[base | (cycle_elements[begin] << start)] = carried;
+                begin = end;
+            }
+        }
+    }
+
+    std::string describe() const override {
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            std::string description = describeGate("PORACLE", {start, count}) + ":";
+            for (size_t i = 0; i < function.values.size(); i++) {
+                description += (i > 0 ? "," : "") + std::to_string(function.values[i]);
+            }
+            return description;
+        }
+        return "";
+    }
+
+    int getStart() const { return start; }
+    int getCount() const { return count; }
+    int getCycleCount() const { return int(cycle_ends.size()); }
+};
+
+// Phase Oracle Gate
+// Applies |x⟩ → e^(iπ·f(x))|x⟩ where x is the value of a qubit range, in a
+// single diagonal pass with no ancilla qubits. 'function' may be
+// - a predicate returning bool: marked states get a phase of -1
+// - a phase function returning a number f(x) (f = 1/2 gives i, etc.)
+// For phase functions the 2^count phase factors are tabulated once when
+// the gate is built, so the pass is a plain table-indexed multiply.
+template <typename Function>
+class PhaseOracleGate : public QuantumGate {
+private:
+    typedef typename std::decay<decltype(std::declval<const Function&>()(uint64_t(0)))>::type Result;
+    static constexpr bool IS_PREDICATE = std::is_same<Result, bool>::value;
+
+    int start;
+    int count;
+    Function function;
+    std::vector<Complex> phases;  // e^(iπ·f(x)) per register value (phase functions only)
+
+public:
+    PhaseOracleGate(int start, int count, Function function)
+        : start(start), count(count), function(function) {
+        if (start < 0) {
+            throw std::invalid_argument("Qubit positions must be non-negative");
+        }
+        if (count <= 0 || count > 30) {
+            throw std::invalid_argument("Register size must be between 1 and 30");
+        }
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            if (function.values.size() != (size_t(1) << count)) {
+                throw std::invalid_argument("Function table needs 2^count entries");
+            }
+        }
+        if constexpr (!IS_PREDICATE) {
+            phases.resize(size_t(1) << count);
+            for (size_t x = 0; x < phases.size(); x++) {
+                double angle = M_PI * double(function(uint64_t(x)));
+                phases[x] = Complex(std::cos(angle), std::sin(angle));
+            }
+        }
+    }
+
+    void apply(QuantumState& state) override {
+        if (start + count > state.getNumQubits()) {
+            throw std::invalid_argument("Register exceeds number of qubits in state");
+        }
+
+        int state_size = state.getStateSize();
+        Complex* amplitudes = state.data();
+        uint64_t mask = (uint64_t(1) << count) - 1;
+
+        if constexpr (IS_PREDICATE) {
+            QS_PARALLEL_FOR
+            for (int i = 0; i < state_size; i++) {
+                if (function((uint64_t(i) >> start) & mask)) {
+                    amplitudes[i] = -amplitudes[i];
+                }
+            }
+        } else {
+            const Complex* table = phases.data();
+            QS_PARALLEL_FOR
+            for (int i = 0; i < state_size; i++) {
+                amplitudes[i] = complexMul(amplitudes[i], table[(uint64_t(i) >> start) & mask]);
+            }
+        }
+    }
+
+    std::string describe() const override {
+        if constexpr (std::is_same<Function, FunctionTable>::value) {
+            std::string description = describeGate("PHORACLE", {start, count}) + ":";
+            for (size_t i = 0; i < function.values.size(); i++) {
+                description += (i > 0 ? "," : "") + std::to_string(function.values[i]);
+            }
+            return description;
+        }
+        return "";
+    }
+
+    int getStart() const { return start; }
+    int getCount() const { return count; }
+};
+
+#endif // QUANTUM_ORACLE_H
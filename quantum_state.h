@@ -5,31 +5,311 @@
 #include <complex>
 #include <iostream>
 #include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <algorithm>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // Type definitions for quantum simulation
 typedef std::complex<double> Complex;
 
+// Parallel loop over basis states
+// Expands to an OpenMP pragma when compiled with -fopenmp and to nothing
+// otherwise, so kernels stay serial (and warning-free) in default builds
+// QS_PARALLEL_SUM(a, b) additionally reduces the named doubles with +
+#ifdef _OPENMP
+#define QS_PRAGMA(text) _Pragma(#text)
+#define QS_PARALLEL_FOR _Pragma("omp parallel for schedule(static)")
+#define QS_PARALLEL_SUM(...) QS_PRAGMA(omp parallel for schedule(static) reduction(+:__VA_ARGS__))
+#else
+#define QS_PARALLEL_FOR
+#define QS_PARALLEL_SUM(...)
+#endif
+
+// Contiguous amplitude storage with copy-on-write forking
+// Small buffers live on the heap. Large buffers are page-aligned mappings;
+// on Linux the first fork() places the contents in an anonymous memory
+// file (the backing file) and maps it MAP_PRIVATE into both the original
+// and the fork, so the kernel shares every page until one side writes to
+// it. The backing file is never written again: the original, the fork and
+// every later fork of either keep mapping the same file, so N siblings of
+// one state share one copy of it and each pays only for the pages it
+// modifies. Only a fork of a buffer that has written pages since it was
+// mapped (checked in /proc/self/pagemap) needs a new backing file, which
+// costs one sequential pass over the data.
+// On other platforms fork() falls back to a deep copy.
+class AmplitudeBuffer {
+private:
+    Complex* values;
+    size_t count;
+    size_t mapped_bytes;  // 0 if the buffer is heap-allocated
+    int backing_fd;       // Memory file mapped MAP_PRIVATE, -1 if none
+
+    // Buffers below this size are not worth a mapping of their own
+    static constexpr size_t MAP_THRESHOLD_BYTES = 64 * 1024;
+
+    static size_t pageRound(size_t bytes) {
+#ifdef __linux__
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+#else
+        return bytes;
+#endif
+    }
+
+    // Allocate zero-initialized storage for n amplitudes
+    void allocate(size_t n) {
+        count = n;
+        mapped_bytes = 0;
+        if (n == 0) {
+            values = nullptr;
+            return;
+        }
+        size_t bytes = n * sizeof(Complex);
+#ifdef __linux__
+        if (bytes >= MAP_THRESHOLD_BYTES) {
+            size_t length = pageRound(bytes);
+            void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            values = static_cast<Complex*>(memory);
+            mapped_bytes = length;
+            return;
+        }
+#endif
+        values = new Complex[n]();
+    }
+
+    void release() {
+#ifdef __linux__
+        if (backing_fd >= 0) {
+            close(backing_fd);
+            backing_fd = -1;
+        }
+#endif
+        if (values == nullptr) {
+            return;
+        }
+#ifdef __linux__
+        if (mapped_bytes != 0) {
+            munmap(values, mapped_bytes);
+            values = nullptr;
+            return;
+        }
+#endif
+        delete[] values;
+        values = nullptr;
+    }
+
+#ifdef __linux__
+    // True if any page of the mapping no longer comes from the backing
+    // file: present as a private anonymous copy, or swapped out (only
+    // anonymous pages are). Unreadable pagemap counts as modified.
+    bool modifiedSinceMapped() const {
+        int pagemap = open("/proc/self/pagemap", O_RDONLY);
+        if (pagemap < 0) {
+            return true;
+        }
+        const uint64_t PRESENT = uint64_t(1) << 63;
+        const uint64_t SWAPPED = uint64_t(1) << 62;
+        const uint64_t FILE_PAGE = uint64_t(1) << 61;
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t first = reinterpret_cast<uintptr_t>(values) / page;
+        size_t pages = mapped_bytes / page;
+        std::vector<uint64_t> entries(4096);
+        bool modified = false;
+        for (size_t done = 0; done < pages && !modified; done += entries.size()) {
+            size_t chunk = std::min(entries.size(), pages - done);
+            size_t bytes = chunk * sizeof(uint64_t);
+            if (pread(pagemap, entries.data(), bytes, static_cast<off_t>((first + done) * sizeof(uint64_t))) !=
+                static_cast<ssize_t>(bytes)) {
+                modified = true;
+                break;
+            }
+            for (size_t i = 0; i < chunk; i++) {
+                if ((entries[i] & SWAPPED) || ((entries[i] & PRESENT) && !(entries[i] & FILE_PAGE))) {
+                    modified = true;
+                    break;
+                }
+            }
+        }
+        close(pagemap);
+        return modified;
+    }
+
+    // Copy the current contents into a new memory file and remap this
+    // buffer onto it; returns false (buffer unchanged) on failure
+    bool remapOntoNewFile() {
+        int fd = memfd_create("quantum_state", 0);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ftruncate(fd, static_cast<off_t>(mapped_bytes)) == 0;
+        size_t written = 0;
+        const char* source = reinterpret_cast<const char*>(values);
+        while (ok && written < mapped_bytes) {
+            ssize_t n = pwrite(fd, source + written, mapped_bytes - written, static_cast<off_t>(written));
+            ok = n > 0;
+            written += ok ? static_cast<size_t>(n) : 0;
+        }
+        // Replace our own pages with a private mapping of the file
+        if (!ok || mmap(values, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) ==
+                       MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        if (backing_fd >= 0) {
+            close(backing_fd);
+        }
+        backing_fd = fd;
+        return true;
+    }
+#endif
+
+public:
+    explicit AmplitudeBuffer(size_t n = 0) : values(nullptr), count(0), mapped_bytes(0), backing_fd(-1) {
+        allocate(n);
+    }
+
+    AmplitudeBuffer(const AmplitudeBuffer& other) : values(nullptr), count(0), mapped_bytes(0), backing_fd(-1) {
+        allocate(other.count);
+        std::memcpy(static_cast<void*>(values), other.values, count * sizeof(Complex));
+    }
+
+    AmplitudeBuffer(AmplitudeBuffer&& other) noexcept
+        : values(other.values), count(other.count), mapped_bytes(other.mapped_bytes), backing_fd(other.backing_fd) {
+        other.values = nullptr;
+        other.count = 0;
+        other.mapped_bytes = 0;
+        other.backing_fd = -1;
+    }
+
+    AmplitudeBuffer& operator=(const AmplitudeBuffer& other) {
+        if (this != &other) {
+            AmplitudeBuffer copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    AmplitudeBuffer& operator=(AmplitudeBuffer&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~AmplitudeBuffer() {
+        release();
+    }
+
+    void swap(AmplitudeBuffer& other) noexcept {
+        std::swap(values, other.values);
+        std::swap(count, other.count);
+        std::swap(mapped_bytes, other.mapped_bytes);
+        std::swap(backing_fd, other.backing_fd);
+    }
+
+    // Copy-on-write fork (see class comment); contents of *this are unchanged
+    AmplitudeBuffer fork() {
+#ifdef __linux__
+        if (mapped_bytes != 0 &&
+            ((backing_fd >= 0 && !modifiedSinceMapped()) || remapOntoNewFile())) {
+            int fd = dup(backing_fd);
+            void* child = fd >= 0 ? mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)
+                                  : MAP_FAILED;
+            if (child != MAP_FAILED) {
+                AmplitudeBuffer result;
+                result.values = static_cast<Complex*>(child);
+                result.count = count;
+                result.mapped_bytes = mapped_bytes;
+                result.backing_fd = fd;
+                return result;
+            }
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+        return AmplitudeBuffer(*this);
+    }
+
+    size_t size() const { return count; }
+    Complex* data() { return values; }
+    const Complex* data() const { return values; }
+    Complex& operator[](size_t index) { return values[index]; }
+    const Complex& operator[](size_t index) const { return values[index]; }
+    Complex* begin() { return values; }
+    Complex* end() { return values + count; }
+    const Complex* begin() const { return values; }
+    const Complex* end() const { return values + count; }
+
+    // Copy into a std::vector, so code written against the vector-based
+    // getAmplitudes() (std::vector<Complex> v = state.getAmplitudes();)
+    // still compiles
+    operator std::vector<Complex>() const {
+        return std::vector<Complex>(values, values + count);
+    }
+};
+
 class QuantumState {
 private:
-    std::vector<Complex> amplitudes;
+    AmplitudeBuffer amplitudes;
     int num_qubits;
     int state_size;
+    bool double_buffered;
+    AmplitudeBuffer back_buffer;  // Gather target in double-buffered mode
+
+    // Used by fork(): adopt an existing buffer
+    QuantumState(int n, AmplitudeBuffer&& buffer)
+        : amplitudes(std::move(buffer)), num_qubits(n), state_size(1 << n), double_buffered(false) {}
 
 public:
     // Constructor: Initialize quantum state with n qubits
     // All qubits start in |0⟩ state, so the state is |00...0⟩
-    QuantumState(int n) : num_qubits(n) {
+    QuantumState(int n) : num_qubits(n), double_buffered(false) {
         if (n <= 0) {
             throw std::invalid_argument("Number of qubits must be positive");
         }
 
         state_size = 1 << n;  // 2^n
-        amplitudes.resize(state_size, 0.0);
+        amplitudes = AmplitudeBuffer(state_size);
 
         // Initialize to |00...0⟩ state
         amplitudes[0] = 1.0;
     }
 
+    // Copies take the amplitudes and the buffering mode, not the back buffer
+    QuantumState(const QuantumState& other)
+        : amplitudes(other.amplitudes), num_qubits(other.num_qubits), state_size(other.state_size),
+          double_buffered(other.double_buffered) {}
+
+    QuantumState& operator=(const QuantumState& other) {
+        if (this != &other) {
+            amplitudes = other.amplitudes;
+            num_qubits = other.num_qubits;
+            state_size = other.state_size;
+            double_buffered = other.double_buffered;
+            if (!double_buffered || back_buffer.size() != amplitudes.size()) {
+                back_buffer = AmplitudeBuffer();
+            }
+        }
+        return *this;
+    }
+
+    QuantumState(QuantumState&& other) = default;
+    QuantumState& operator=(QuantumState&& other) = default;
+
     // Get the number of qubits
     int getNumQubits() const {
         return num_qubits;
@@ -56,6 +336,14 @@ public:
         amplitudes[index] = amplitude;
     }
 
+    // Replace all amplitudes at once (size must match the state)
+    void setAmplitudes(const std::vector<Complex>& new_amplitudes) {
+        if (static_cast<int>(new_amplitudes.size()) != state_size) {
+            throw std::invalid_argument("Amplitude vector size does not match state size");
+        }
+        std::copy(new_amplitudes.begin(), new_amplitudes.end(), amplitudes.begin());
+    }
+
     // Get the probability of measuring a specific basis state
     // Probability = |amplitude|^2
     double getProbability(int index) const {
@@ -65,11 +353,53 @@ public:
         return std::norm(amplitudes[index]);
     }
 
-    // Get all amplitudes
-    const std::vector<Complex>& getAmplitudes() const {
+    // Get all amplitudes (converts to std::vector<Complex> on copy)
+    const AmplitudeBuffer& getAmplitudes() const {
         return amplitudes;
     }
 
+    // Direct access to the amplitude array for in-place gate kernels
+    // No bounds checking; index i holds the amplitude of basis state |i⟩
+    Complex* data() { return amplitudes.data(); }
+    const Complex* data() const { return amplitudes.data(); }
+
+    // Copy-on-write copy of this state for branching simulations
+    // The fork and the original share memory pages until either one
+    // modifies them, so exploring several continuations of a common
+    // prefix costs only the pages each branch actually touches
+    // The fork is single-buffered
+    QuantumState fork() {
+        return QuantumState(num_qubits, amplitudes.fork());
+    }
+
+    // Double-buffered execution
+    // Out-of-place permutation gates (controlled modular multiplication,
+    // register swaps) normally snapshot the state and write moved entries
+    // back. In double-buffered mode the state keeps a second buffer of the
+    // same size: such gates gather every amplitude into it in index order,
+    // then the buffers swap. This doubles memory but turns the pass into
+    // one sequential write stream (see gatherPermutation).
+    void setDoubleBuffered(bool enabled) {
+        double_buffered = enabled;
+        back_buffer = enabled ? AmplitudeBuffer(state_size) : AmplitudeBuffer();
+    }
+
+    bool isDoubleBuffered() const { return double_buffered; }
+
+    // Second buffer for out-of-place kernels, allocated on first use;
+    // contents are unspecified. Only valid in double-buffered mode
+    Complex* backData() {
+        if (back_buffer.size() != amplitudes.size()) {
+            back_buffer = AmplitudeBuffer(state_size);
+        }
+        return back_buffer.data();
+    }
+
+    // Make the back buffer the state (and the old state the back buffer)
+    void swapBuffers() {
+        amplitudes.swap(back_buffer);
+    }
+
     // Print the quantum state in a readable format
     void printState() const {
         std::cout << "Quantum State (" << num_qubits << " qubits):" << std::endl;
@@ -102,8 +432,58 @@ public:
 
     // Get memory usage in bytes
     size_t getMemoryUsage() const {
-        return state_size * sizeof(Complex);
+        return (state_size + back_buffer.size()) * sizeof(Complex);
     }
 };
 
+// Out-of-place permutation in double-buffered mode: out[j] = in[source(j)]
+// 'source' is the inverse of the basis-state map and must be a bijection
+// on [0, state_size). The back buffer is written strictly in index order,
+// so states larger than the last-level cache use non-temporal (streaming)
+// stores that bypass the cache and skip the read-for-ownership of each
+// line, while the scattered reads are prefetched a fixed distance ahead.
+// Runs in parallel over blocks of GATHER_BLOCK amplitudes, then swaps.
+const int GATHER_BLOCK = 4096;
+const int GATHER_PREFETCH_DISTANCE = 16;
+const size_t STREAMING_THRESHOLD_BYTES = size_t(8) << 20;
+
+template <typename Source>
+void gatherPermutation(QuantumState& state, Source source) {
+    int state_size = state.getStateSize();
+    const Complex* in = state.data();
+    Complex* out = state.backData();
+    bool streaming = state_size * sizeof(Complex) >= STREAMING_THRESHOLD_BYTES &&
+                     reinterpret_cast<uintptr_t>(out) % 16 == 0;
+#ifndef __SSE2__
+    (void)streaming;
+#endif
+    int blocks = (state_size + GATHER_BLOCK - 1) / GATHER_BLOCK;
+
+    QS_PARALLEL_FOR
+    for (int b = 0; b < blocks; b++) {
+        int begin = b * GATHER_BLOCK;
+        int end = std::min(state_size, begin + GATHER_BLOCK);
+        for (int j = begin; j < end; j++) {
+            if (j + GATHER_PREFETCH_DISTANCE < end) {
+                __builtin_prefetch(in + source(j + GATHER_PREFETCH_DISTANCE));
+            }
+            const Complex& value = in[source(j)];
+#ifdef __SSE2__
+            if (streaming) {
+                _mm_stream_pd(reinterpret_cast<double*>(out + j),
+                              _mm_loadu_pd(reinterpret_cast<const double*>(&value)));
+                continue;
+            }
+#endif
+            out[j] = value;
+        }
+#ifdef __SSE2__
+        if (streaming) {
+            _mm_sfence();  // Streaming stores are weakly ordered
+        }
+#endif
+    }
+    state.swapBuffers();
+}
+
 #endif // QUANTUM_STATE_H
@@ -0,0 +1,635 @@
+#ifndef SPARSE_STATE_H
+#define SPARSE_STATE_H
+
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// (a · b) mod m without overflow for any 64-bit operands
+inline uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m) {
+    return uint64_t((unsigned __int128)a * b % m);
+}
+
+// Basis index of up to 64·WORDS qubits
+// Qubit q is bit (q % 64) of words[q / 64], so the first word matches the
+// int indices of QuantumState. Register fields of up to 64 bits may
+// straddle a word boundary.
+template <int WORDS>
+struct WideIndex {
+    uint64_t words[WORDS];
+
+    WideIndex() : words{} {}
+
+    bool bit(int q) const {
+        return (words[q >> 6] >> (q & 63)) & 1;
+    }
+
+    void flip(int q) {
+        words[q >> 6] ^= uint64_t(1) << (q & 63);
+    }
+
+    // True if every qubit of 'mask' is 1
+    bool covers(const WideIndex& mask) const {
+        for (int w = 0; w < WORDS; w++) {
+            if ((words[w] & mask.words[w]) != mask.words[w]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Value of qubits [start, start + count), count ≤ 64
+    uint64_t field(int start, int count) const {
+        int w = start >> 6;
+        int offset = start & 63;
+        uint64_t value = words[w] >> offset;
+        if (offset != 0 && offset + count > 64 && w + 1 < WORDS) {
+            value |= words[w + 1] << (64 - offset);
+        }
+        return count == 64 ? value : value & ((uint64_t(1) << count) - 1);
+    }
+
+    // Replace qubits [start, start + count) by 'value', count ≤ 64
+    void setField(int start, int count, uint64_t value) {
+        uint64_t mask = count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+        value &= mask;
+        int w = start >> 6;
+        int offset = start & 63;
+        words[w] = (words[w] & ~(mask << offset)) | (value << offset);
+        if (offset != 0 && offset + count > 64 && w + 1 < WORDS) {
+            int spill = 64 - offset;
+            words[w + 1] = (words[w + 1] & ~(mask >> spill)) | (value >> spill);
+        }
+    }
+
+    bool operator==(const WideIndex& other) const {
+        return std::equal(words, words + WORDS, other.words);
+    }
+
+    // Numeric order (most significant word first)
+    bool operator<(const WideIndex& other) const {
+        for (int w = WORDS - 1; w >= 0; w--) {
+            if (words[w] != other.words[w]) {
+                return words[w] < other.words[w];
+            }
+        }
+        return false;
+    }
+};
+
+// Hash of a wide index: every word goes through a 64-bit mixer
+template <int WORDS>
+struct WideIndexHash {
+    size_t operator()(const WideIndex<WORDS>& index) const {
+        uint64_t hash = 0;
+        for (int w = 0; w < WORDS; w++) {
+            uint64_t x = index.words[w] + 0x9E3779B97F4A7C15ULL * (w + 1) + (hash << 6) + (hash >> 2);
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            hash ^= x ^ (x >> 31);
+        }
+        return size_t(hash);
+    }
+};
+
+// Amplitude magnitude below which sparse kernels drop an entry
+constexpr double SPARSE_ZERO_TOLERANCE = 1e-14;
+
+inline void requireSparseQubit(int q, int num_qubits) {
+    if (q < 0 || q >= num_qubits) {
+        throw std::invalid_argument("Gate qubit exceeds number of qubits in state");
+    }
+}
+
+inline void requireSparseRegister(int start, int count, int num_qubits) {
+    requireSparseQubit(start, num_qubits);
+    requireSparseQubit(start + count - 1, num_qubits);
+}
+
+// Exchange two registers of any width in 64-qubit chunks
+template <int WORDS>
+void swapIndexFields(WideIndex<WORDS>& key, int a_start, int b_start, int count) {
+    for (int offset = 0; offset < count; offset += 64) {
+        int chunk = std::min(64, count - offset);
+        uint64_t a = key.field(a_start + offset, chunk);
+        uint64_t b = key.field(b_start + offset, chunk);
+        key.setField(a_start + offset, chunk, b);
+        key.setField(b_start + offset, chunk, a);
+    }
+}
+
+// Sparse kernel of a known gate, shared by the sparse representations
+// Translates the gate into one call on 'backend', with the index math done
+// on WideIndex keys:
+// - permutation gates (X, CNOT, SWAP, Toffoli, modular multiplications,
+//   register swaps): backend.permute(map), map taking and returning a key
+// - phase gates: backend.applyPhase(mask, angle) for keys covering mask
+// - Hadamard: backend.applyHadamard(target)
+// Returns false (nothing applied) for any other gate, and for modular
+// multiplications whose map is not a permutation (see
+// isModMultPermutation), which no backend can apply as one.
+template <int WORDS, typename Backend>
+bool dispatchSparseGate(const QuantumGate& gate, int num_qubits, Backend& backend) {
+    typedef WideIndex<WORDS> Index;
+    if (auto g = dynamic_cast<const XGate*>(&gate)) {
+        int target = g->getTarget();
+        requireSparseQubit(target, num_qubits);
+        backend.permute([=](Index key) { key.flip(target); return key; });
+        return true;
+    }
+    if (auto g = dynamic_cast<const CNOTGate*>(&gate)) {
+        int control = g->getControl();
+        int target = g->getTarget();
+        requireSparseQubit(control, num_qubits);
+        requireSparseQubit(target, num_qubits);
+        backend.permute([=](Index key) {
+            if (key.bit(control)) {
+                key.flip(target);
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const SWAPGate*>(&gate)) {
+        int q1 = g->getQubit1();
+        int q2 = g->getQubit2();
+        requireSparseQubit(q1, num_qubits);
+        requireSparseQubit(q2, num_qubits);
+        backend.permute([=](Index key) {
+            if (key.bit(q1) != key.bit(q2)) {
+                key.flip(q1);
+                key.flip(q2);
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const ToffoliGate*>(&gate)) {
+        int c1 = g->getControl1();
+        int c2 = g->getControl2();
+        int target = g->getTarget();
+        requireSparseQubit(c1, num_qubits);
+        requireSparseQubit(c2, num_qubits);
+        requireSparseQubit(target, num_qubits);
+        backend.permute([=](Index key) {
+            if (key.bit(c1) && key.bit(c2)) {
+                key.flip(target);
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const ControlledModMultGate*>(&gate)) {
+        int control = g->getControl();
+        int start = g->getTargetStart();
+        int count = g->getTargetCount();
+        uint64_t multiplier = g->getMultiplier();
+        uint64_t modulus = g->getModulus();
+        requireSparseQubit(control, num_qubits);
+        requireSparseRegister(start, count, num_qubits);
+        if (count > 64) {
+            throw std::invalid_argument("Sparse modular multiplication supports at most 64 target qubits");
+        }
+        if (!isModMultPermutation(multiplier, modulus, count)) {
+            return false;
+        }
+        backend.permute([=](Index key) {
+            uint64_t y = key.field(start, count);
+            if (key.bit(control) && y < modulus) {
+                key.setField(start, count, mulMod(multiplier, y, modulus));
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const LookupModMultGate*>(&gate)) {
+        int window_start = g->getWindowStart();
+        int window_size = g->getWindowSize();
+        int start = g->getTargetStart();
+        int count = g->getTargetCount();
+        const std::vector<uint64_t>& multipliers = g->getMultipliers();
+        uint64_t modulus = g->getModulus();
+        requireSparseRegister(window_start, window_size, num_qubits);
+        requireSparseRegister(start, count, num_qubits);
+        if (count > 64) {
+            throw std::invalid_argument("Sparse modular multiplication supports at most 64 target qubits");
+        }
+        for (uint64_t multiplier : multipliers) {
+            if (!isModMultPermutation(multiplier, modulus, count)) {
+                return false;
+            }
+        }
+        backend.permute([&](Index key) {
+            uint64_t y = key.field(start, count);
+            if (y < modulus) {
+                uint64_t multiplier = multipliers[key.field(window_start, window_size)];
+                key.setField(start, count, mulMod(multiplier, y, modulus));
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const RegisterSwapGate*>(&gate)) {
+        int a = g->getAStart();
+        int b = g->getBStart();
+        int count = g->getCount();
+        requireSparseRegister(a, count, num_qubits);
+        requireSparseRegister(b, count, num_qubits);
+        backend.permute([=](Index key) { swapIndexFields(key, a, b, count); return key; });
+        return true;
+    }
+    if (auto g = dynamic_cast<const ControlledRegisterSwapGate*>(&gate)) {
+        int control = g->getControl();
+        int a = g->getAStart();
+        int b = g->getBStart();
+        int count = g->getCount();
+        requireSparseQubit(control, num_qubits);
+        requireSparseRegister(a, count, num_qubits);
+        requireSparseRegister(b, count, num_qubits);
+        backend.permute([=](Index key) {
+            if (key.bit(control)) {
+                swapIndexFields(key, a, b, count);
+            }
+            return key;
+        });
+        return true;
+    }
+    if (auto g = dynamic_cast<const PhaseShiftGate*>(&gate)) {
+        requireSparseQubit(g->getTarget(), num_qubits);
+        Index mask;
+        mask.flip(g->getTarget());
+        backend.applyPhase(mask, g->getPhase());
+        return true;
+    }
+    if (auto g = dynamic_cast<const ControlledPhaseShiftGate*>(&gate)) {
+        requireSparseQubit(g->getTarget(), num_qubits);
+        Index mask;
+        mask.flip(g->getTarget());
+        for (int control : g->getControls()) {
+            requireSparseQubit(control, num_qubits);
+            mask.flip(control);
+        }
+        backend.applyPhase(mask, g->getPhase());
+        return true;
+    }
+    if (auto g = dynamic_cast<const HadamardGate*>(&gate)) {
+        requireSparseQubit(g->getTarget(), num_qubits);
+        backend.applyHadamard(g->getTarget());
+        return true;
+    }
+    return false;
+}
+
+// Sparse State: only nonzero amplitudes, keyed by wide basis indices
+// Memory and time scale with the number of nonzero amplitudes, not with
+// 2^num_qubits, and qubit positions are not capped by the width of int:
+// a SparseState<2> holds up to 128 qubits. Gates run through
+// dispatchSparseGate on a hash map:
+// - permutation gates move each entry to its new key
+// - phase gates multiply entries in place
+// - Hadamards split each entry in two and drop amplitudes that cancel
+// Composite gates are expanded through decompose(); any other gate has
+// no sparse kernel and is rejected.
+template <int WORDS>
+class SparseState {
+public:
+    typedef WideIndex<WORDS> Index;
+    typedef std::unordered_map<Index, Complex, WideIndexHash<WORDS>> AmplitudeMap;
+
+    static const int MAX_QUBITS = 64 * WORDS;
+
+    // Amplitudes with smaller magnitude after interference are dropped
+    static constexpr double ZERO_TOLERANCE = SPARSE_ZERO_TOLERANCE;
+
+private:
+    int num_qubits;
+    AmplitudeMap amplitudes;
+
+public:
+    // Constructor: n qubits in |00...0⟩
+    SparseState(int n) : num_qubits(n) {
+        if (n <= 0 || n > MAX_QUBITS) {
+            throw std::invalid_argument("Number of qubits must be between 1 and " + std::to_string(MAX_QUBITS));
+        }
+        amplitudes.emplace(Index(), Complex(1, 0));
+    }
+
+    // Apply a gate; composite gates are expanded through decompose()
+    void apply(QuantumGate& gate) {
+        if (dispatchSparseGate<WORDS>(gate, num_qubits, *this)) {
+            return;
+        }
+        std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+        if (parts.empty()) {
+            throw std::invalid_argument("Gate has no sparse kernel and no decomposition");
+        }
+        for (const auto& part : parts) {
+            apply(*part);
+        }
+    }
+
+    // Kernel hooks called by dispatchSparseGate
+
+    // Move every entry to map(key); 'map' must be a bijection
+    template <typename Map>
+    void permute(Map map) {
+        AmplitudeMap moved;
+        moved.reserve(amplitudes.size());
+        for (const auto& entry : amplitudes) {
+            moved.emplace(map(entry.first), entry.second);
+        }
+        amplitudes.swap(moved);
+    }
+
+    // Multiply the entries whose keys cover 'mask' by e^(i·angle)
+    void applyPhase(const Index& mask, double angle) {
+        Complex factor(std::cos(angle), std::sin(angle));
+        for (auto& entry : amplitudes) {
+            if (entry.first.covers(mask)) {
+                entry.second = complexMul(entry.second, factor);
+            }
+        }
+    }
+
+    void applyHadamard(int target) {
+        const double inv_sqrt2 = 1.0 / std::sqrt(2.0);
+        AmplitudeMap mixed;
+        mixed.reserve(2 * amplitudes.size());
+        for (const auto& entry : amplitudes) {
+            Index zero = entry.first;
+            bool was_one = zero.bit(target);
+            if (was_one) {
+                zero.flip(target);
+            }
+            Index one = zero;
+            one.flip(target);
+            Complex half = entry.second * inv_sqrt2;
+            mixed[zero] += half;
+            mixed[one] += was_one ? -half : half;
+        }
+        for (auto it = mixed.begin(); it != mixed.end();) {
+            if (std::abs(it->second) < SPARSE_ZERO_TOLERANCE) {
+                it = mixed.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        amplitudes.swap(mixed);
+    }
+
+    // Replace the contents by the given (key, amplitude) entries
+    template <typename Iterator>
+    void assign(Iterator begin, Iterator end, size_t count) {
+        AmplitudeMap filled;
+        filled.reserve(count);
+        for (Iterator it = begin; it != end; ++it) {
+            filled.emplace(it->first, it->second);
+        }
+        amplitudes.swap(filled);
+    }
+
+    // Drop entries with probability below 'threshold'; returns the
+    // probability mass removed. The state is left unnormalized
+    double prune(double threshold) {
+        double removed = 0.0;
+        for (auto it = amplitudes.begin(); it != amplitudes.end();) {
+            double probability = std::norm(it->second);
+            if (probability < threshold) {
+                removed += probability;
+                it = amplitudes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+    // Multiply every amplitude by 'factor' (renormalization)
+    void scale(double factor) {
+        for (auto& entry : amplitudes) {
+            entry.second *= factor;
+        }
+    }
+
+    // Probability of every stored entry, in unspecified order
+    std::vector<double> getProbabilities() const {
+        std::vector<double> probabilities;
+        probabilities.reserve(amplitudes.size());
+        for (const auto& entry : amplitudes) {
+            probabilities.push_back(std::norm(entry.second));
+        }
+        return probabilities;
+    }
+
+    int getNumQubits() const { return num_qubits; }
+
+    // Number of stored (nonzero) amplitudes
+    size_t getNonzeroCount() const { return amplitudes.size(); }
+
+    // All nonzero amplitudes, in unspecified order
+    const AmplitudeMap& getAmplitudes() const { return amplitudes; }
+
+    Complex getAmplitude(const Index& index) const {
+        auto it = amplitudes.find(index);
+        return it == amplitudes.end() ? Complex(0, 0) : it->second;
+    }
+
+    double getProbability(const Index& index) const {
+        return std::norm(getAmplitude(index));
+    }
+
+    // Sum of |amplitude|^2, 1 for a normalized state
+    double getNorm() const {
+        double norm = 0.0;
+        for (const auto& entry : amplitudes) {
+            norm += std::norm(entry.second);
+        }
+        return norm;
+    }
+
+    // Approximate heap usage: entries, node overhead and bucket array
+    size_t getMemoryUsage() const {
+        size_t node = sizeof(Index) + sizeof(Complex) + 2 * sizeof(void*);
+        return amplitudes.size() * node + amplitudes.bucket_count() * sizeof(void*);
+    }
+};
+
+// Sorted Sparse State: nonzero amplitudes as a vector sorted by key
+// About half the memory of the hash map per entry and sequential access,
+// at the price of a sort after gates that reorder keys. Runs the same
+// dispatchSparseGate kernels as SparseState:
+// - permutations rewrite keys in place, then re-sort if needed
+// - phase gates multiply entries in place
+// - Hadamards emit two entries per entry, then sort and combine equal keys
+template <int WORDS>
+class SortedSparseState {
+public:
+    typedef WideIndex<WORDS> Index;
+    typedef std::pair<Index, Complex> Entry;
+
+    static const int MAX_QUBITS = 64 * WORDS;
+
+private:
+    int num_qubits;
+    std::vector<Entry> entries;
+
+    static bool keyLess(const Entry& lhs, const Entry& rhs) {
+        return lhs.first < rhs.first;
+    }
+
+    void sortEntries() {
+        if (!std::is_sorted(entries.begin(), entries.end(), keyLess)) {
+            std::sort(entries.begin(), entries.end(), keyLess);
+        }
+    }
+
+public:
+    // Constructor: n qubits in |00...0⟩
+    SortedSparseState(int n) : num_qubits(n) {
+        if (n <= 0 || n > MAX_QUBITS) {
+            throw std::invalid_argument("Number of qubits must be between 1 and " + std::to_string(MAX_QUBITS));
+        }
+        entries.emplace_back(Index(), Complex(1, 0));
+    }
+
+    // Apply a gate; composite gates are expanded through decompose()
+    void apply(QuantumGate& gate) {
+        if (dispatchSparseGate<WORDS>(gate, num_qubits, *this)) {
+            return;
+        }
+        std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+        if (parts.empty()) {
+            throw std::invalid_argument("Gate has no sparse kernel and no decomposition");
+        }
+        for (const auto& part : parts) {
+            apply(*part);
+        }
+    }
+
+    // Kernel hooks called by dispatchSparseGate
+
+    template <typename Map>
+    void permute(Map map) {
+        for (Entry& entry : entries) {
+            entry.first = map(entry.first);
+        }
+        sortEntries();
+    }
+
+    void applyPhase(const Index& mask, double angle) {
+        Complex factor(std::cos(angle), std::sin(angle));
+        for (Entry& entry : entries) {
+            if (entry.first.covers(mask)) {
+                entry.second = complexMul(entry.second, factor);
+            }
+        }
+    }
+
+    void applyHadamard(int target) {
+        const double inv_sqrt2 = 1.0 / std::sqrt(2.0);
+        std::vector<Entry> mixed;
+        mixed.reserve(2 * entries.size());
+        for (const Entry& entry : entries) {
+            Index zero = entry.first;
+            bool was_one = zero.bit(target);
+            if (was_one) {
+                zero.flip(target);
+            }
+            Index one = zero;
+            one.flip(target);
+            Complex half = entry.second * inv_sqrt2;
+            mixed.emplace_back(zero, half);
+            mixed.emplace_back(one, was_one ? -half : half);
+        }
+        std::sort(mixed.begin(), mixed.end(), keyLess);
+
+        // Combine equal keys, dropping amplitudes that cancel
+        entries.clear();
+        for (size_t k = 0; k < mixed.size();) {
+            Entry combined = mixed[k++];
+            while (k < mixed.size() && mixed[k].first == combined.first) {
+                combined.second += mixed[k++].second;
+            }
+            if (std::abs(combined.second) >= SPARSE_ZERO_TOLERANCE) {
+                entries.push_back(combined);
+            }
+        }
+    }
+
+    // Replace the contents by entries already sorted by key
+    void assignSorted(std::vector<Entry>&& sorted) {
+        entries.swap(sorted);
+    }
+
+    // Drop entries with probability below 'threshold'; returns the
+    // probability mass removed. The state is left unnormalized
+    double prune(double threshold) {
+        double removed = 0.0;
+        size_t kept = 0;
+        for (const Entry& entry : entries) {
+            double probability = std::norm(entry.second);
+            if (probability < threshold) {
+                removed += probability;
+            } else {
+                entries[kept++] = entry;
+            }
+        }
+        entries.resize(kept);
+        return removed;
+    }
+
+    // Multiply every amplitude by 'factor' (renormalization)
+    void scale(double factor) {
+        for (Entry& entry : entries) {
+            entry.second *= factor;
+        }
+    }
+
+    // Probability of every stored entry, in key order
+    std::vector<double> getProbabilities() const {
+        std::vector<double> probabilities;
+        probabilities.reserve(entries.size());
+        for (const Entry& entry : entries) {
+            probabilities.push_back(std::norm(entry.second));
+        }
+        return probabilities;
+    }
+
+    int getNumQubits() const { return num_qubits; }
+    size_t getNonzeroCount() const { return entries.size(); }
+
+    // All nonzero amplitudes in ascending key order
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+    Complex getAmplitude(const Index& index) const {
+        auto it = std::lower_bound(entries.begin(), entries.end(), Entry(index, Complex(0, 0)), keyLess);
+        return (it == entries.end() || !(it->first == index)) ? Complex(0, 0) : it->second;
+    }
+
+    double getProbability(const Index& index) const {
+        return std::norm(getAmplitude(index));
+    }
+
+    // Sum of |amplitude|^2, 1 for a normalized state
+    double getNorm() const {
+        double norm = 0.0;
+        for (const Entry& entry : entries) {
+            norm += std::norm(entry.second);
+        }
+        return norm;
+    }
+
+    size_t getMemoryUsage() const {
+        return entries.capacity() * sizeof(Entry);
+    }
+};
+
+// Sparse state with 128-bit keys
+typedef SparseState<2> SparseState128;
+
+#endif // SPARSE_STATE_H
@@ -0,0 +1,319 @@
+#ifndef STATE_CACHE_H
+#define STATE_CACHE_H
+
+#include "quantum_state.h"
+#include <cstdint>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 64-bit FNV-1a hash, used to fingerprint states and circuit prefixes
+inline uint64_t fnv1a(const void* data, size_t length, uint64_t hash = 14695981039346656037ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Second 64-bit hash, word-wise with its own mixing, stored next to each
+// FNV-1a key so that a key collision alone cannot return a wrong snapshot
+inline uint64_t mixHash(const void* data, size_t length, uint64_t hash = 0x243F6A8885A308D3ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
+    uint64_t tail = uint64_t(length) << 56;
+    for (size_t shift = 0; i < length; i++, shift += 8) {
+        tail ^= uint64_t(bytes[i]) << shift;
+    }
+    hash = (hash ^ tail) * 0xBF58476D1CE4E5B9ULL;
+    return hash ^ (hash >> 31);
+}
+
+// Cache key of a circuit prefix: the FNV-1a hash indexes the cache, the
+// independent check hash must match as well for a lookup to hit
+struct PrefixKey {
+    uint64_t hash;
+    uint64_t check;
+
+    PrefixKey(uint64_t key_hash = 0, uint64_t key_check = 0) : hash(key_hash), check(key_check) {}
+
+    // Key of this prefix followed by 'length' more bytes
+    PrefixKey extend(const void* data, size_t length) const {
+        return PrefixKey(fnv1a(data, length, hash), mixHash(data, length, check));
+    }
+};
+
+// Fingerprint of a quantum state: its raw amplitudes up to the last nonzero
+// one. Trailing zeros are left out, so a state and the same state with
+// extra |0⟩ qubits on top share a fingerprint (see StatePrefixCache::lookup)
+inline PrefixKey fingerprintState(const QuantumState& state) {
+    const Complex* amplitudes = state.data();
+    size_t length = static_cast<size_t>(state.getStateSize());
+    while (length > 0 && amplitudes[length - 1] == Complex(0, 0)) {
+        length--;
+    }
+    size_t bytes = length * sizeof(Complex);
+    return PrefixKey(fnv1a(amplitudes, bytes), mixHash(amplitudes, bytes));
+}
+
+// Cache of intermediate quantum states keyed by circuit-prefix fingerprint
+// A key identifies "initial state + first k gates"; the stored snapshot is
+// the state after those k gates. Snapshots live in memory under an LRU
+// policy bounded by a byte budget. If a directory is given, snapshots that
+// are evicted (or too large for the budget) are spilled to disk and can be
+// loaded back later, also by a different process after persist().
+// Spilled files start with a magic number, a format version and both key
+// hashes; a file that does not match all of them is a miss.
+// Snapshots restore into states of any width: a narrower snapshot is
+// padded with |0⟩ qubits on top, a wider one is accepted only if the
+// amplitudes that do not fit are all zero.
+class StatePrefixCache {
+private:
+    struct Entry {
+        QuantumState snapshot;
+        uint64_t check;
+        std::list<uint64_t>::iterator lru_position;
+    };
+
+    // Header of a spilled snapshot, followed by its amplitudes
+    struct DiskHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t hash;
+        uint64_t check;
+        int32_t num_qubits;
+    };
+    static constexpr char DISK_MAGIC[4] = {'Q', 'S', 'T', 'C'};
+    static constexpr uint32_t DISK_VERSION = 1;
+
+    size_t memory_budget;
+    size_t memory_used;
+    std::string directory;  // Empty: memory only
+    std::unordered_map<uint64_t, Entry> entries;
+    std::list<uint64_t> lru;  // Most recently used at the front
+
+    // Statistics
+    int hits;
+    int misses;
+    int evictions;
+
+    std::string diskPath(uint64_t hash) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.qstate", static_cast<unsigned long long>(hash));
+        return directory + "/" + name;
+    }
+
+    void writeToDisk(const PrefixKey& key, const QuantumState& state) const {
+        if (directory.empty()) {
+            return;
+        }
+        std::ofstream file(diskPath(key.hash), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return;  // Disk tier is best effort
+        }
+        DiskHeader header = {};
+        std::memcpy(header.magic, DISK_MAGIC, sizeof(header.magic));
+        header.version = DISK_VERSION;
+        header.hash = key.hash;
+        header.check = key.check;
+        header.num_qubits = state.getNumQubits();
+        const AmplitudeBuffer& amplitudes = state.getAmplitudes();
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(amplitudes.data()),
+                   static_cast<std::streamsize>(amplitudes.size() * sizeof(Complex)));
+    }
+
+    // Open the spilled snapshot of 'key' and read its header; fails for
+    // files of another format or version and for files of another key
+    bool openOnDisk(const PrefixKey& key, std::ifstream& file, int& num_qubits) const {
+        if (directory.empty()) {
+            return false;
+        }
+        file.open(diskPath(key.hash), std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        DiskHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(header.magic, DISK_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != DISK_VERSION || header.hash != key.hash || header.check != key.check ||
+            header.num_qubits <= 0 || header.num_qubits >= 31) {
+            return false;
+        }
+        num_qubits = header.num_qubits;
+        return true;
+    }
+
+    bool readFromDisk(const PrefixKey& key, QuantumState& state) const {
+        std::ifstream file;
+        int num_qubits = 0;
+        if (!openOnDisk(key, file, num_qubits)) {
+            return false;
+        }
+        std::vector<Complex> amplitudes(size_t(1) << num_qubits);
+        file.read(reinterpret_cast<char*>(amplitudes.data()),
+                  static_cast<std::streamsize>(amplitudes.size() * sizeof(Complex)));
+        if (!file) {
+            return false;
+        }
+        state = QuantumState(num_qubits);
+        state.setAmplitudes(amplitudes);
+        return true;
+    }
+
+    // Copy 'snapshot' into 'state', keeping the width of 'state'
+    static bool fitSnapshot(const QuantumState& snapshot, QuantumState& state) {
+        int size = state.getStateSize();
+        int snapshot_size = snapshot.getStateSize();
+        const Complex* source = snapshot.data();
+        for (int i = size; i < snapshot_size; i++) {
+            if (source[i] != Complex(0, 0)) {
+                return false;
+            }
+        }
+        int common = std::min(size, snapshot_size);
+        Complex* target = state.data();
+        std::copy(source, source + common, target);
+        std::fill(target + common, target + size, Complex(0, 0));
+        return true;
+    }
+
+    void evictUntilFits(size_t incoming) {
+        while (!lru.empty() && memory_used + incoming > memory_budget) {
+            uint64_t victim = lru.back();
+            lru.pop_back();
+            auto it = entries.find(victim);
+            writeToDisk(PrefixKey(victim, it->second.check), it->second.snapshot);
+            memory_used -= it->second.snapshot.getMemoryUsage();
+            entries.erase(it);
+            evictions++;
+        }
+    }
+
+public:
+    // memory_budget_bytes: upper bound on bytes of snapshots held in memory
+    // disk_directory: directory for spilled snapshots ("" = none), created
+    // if it does not exist; throws std::runtime_error if that fails
+    StatePrefixCache(size_t memory_budget_bytes, const std::string& disk_directory = "")
+        : memory_budget(memory_budget_bytes), memory_used(0), directory(disk_directory),
+          hits(0), misses(0), evictions(0) {
+        if (!directory.empty()) {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+            if (!std::filesystem::is_directory(directory)) {
+                throw std::runtime_error("Cannot create cache directory '" + directory + "'" +
+                                         (error ? ": " + error.message() : ""));
+            }
+        }
+    }
+
+    // Store the state reached after the prefix identified by 'key'
+    // An entry under the same hash but another check value is replaced
+    void insert(const PrefixKey& key, const QuantumState& state) {
+        auto existing = entries.find(key.hash);
+        if (existing != entries.end()) {
+            if (existing->second.check == key.check) {
+                lru.splice(lru.begin(), lru, existing->second.lru_position);
+                return;
+            }
+            memory_used -= existing->second.snapshot.getMemoryUsage();
+            lru.erase(existing->second.lru_position);
+            entries.erase(existing);
+        }
+
+        size_t bytes = state.getMemoryUsage();
+        if (bytes > memory_budget) {
+            writeToDisk(key, state);
+            return;
+        }
+
+        evictUntilFits(bytes);
+        lru.push_front(key.hash);
+        entries.emplace(key.hash, Entry{state, key.check, lru.begin()});
+        memory_used += bytes;
+    }
+
+    // Look up a prefix; on a hit, copy the snapshot into 'state', which
+    // keeps its width (a snapshot that does not fit counts as a miss)
+    bool lookup(const PrefixKey& key, QuantumState& state) {
+        auto it = entries.find(key.hash);
+        if (it != entries.end()) {
+            if (it->second.check == key.check && fitSnapshot(it->second.snapshot, state)) {
+                lru.splice(lru.begin(), lru, it->second.lru_position);
+                hits++;
+                return true;
+            }
+        } else {
+            QuantumState loaded(1);
+            if (readFromDisk(key, loaded) && fitSnapshot(loaded, state)) {
+                if (loaded.getMemoryUsage() <= memory_budget) {
+                    insert(key, loaded);  // Promote back into memory
+                }
+                hits++;
+                return true;
+            }
+        }
+        misses++;
+        return false;
+    }
+
+    // Given prefix keys (keys[k] = initial state + first k gates), restore
+    // the longest cached prefix into 'state' and return its length k.
+    // Returns 0 and leaves 'state' untouched if no prefix is cached.
+    size_t resumeLongestPrefix(const std::vector<PrefixKey>& keys, QuantumState& state) {
+        for (size_t k = keys.size() - 1; k > 0; k--) {
+            if (contains(keys[k]) && lookup(keys[k], state)) {
+                return k;
+            }
+        }
+        misses++;
+        return 0;
+    }
+
+    // Check for a prefix without loading it or touching statistics
+    bool contains(const PrefixKey& key) const {
+        auto it = entries.find(key.hash);
+        if (it != entries.end()) {
+            return it->second.check == key.check;
+        }
+        std::ifstream file;
+        int num_qubits = 0;
+        return openOnDisk(key, file, num_qubits);
+    }
+
+    // Write every in-memory snapshot to the disk tier (no-op without a directory)
+    void persist() const {
+        for (const auto& entry : entries) {
+            writeToDisk(PrefixKey(entry.first, entry.second.check), entry.second.snapshot);
+        }
+    }
+
+    void clear() {
+        entries.clear();
+        lru.clear();
+        memory_used = 0;
+    }
+
+    size_t getMemoryUsed() const { return memory_used; }
+    size_t getMemoryBudget() const { return memory_budget; }
+    size_t getEntryCount() const { return entries.size(); }
+    int getHits() const { return hits; }
+    int getMisses() const { return misses; }
+    int getEvictions() const { return evictions; }
+};
+
+#endif // STATE_CACHE_H
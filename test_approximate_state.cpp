@@ -0,0 +1,157 @@
+#include "approximate_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <memory>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Hadamards around a layer of uneven phases: a spread of large and tiny
+// amplitudes over all 2^n basis states
+std::vector<std::shared_ptr<QuantumGate>> spreadCircuit(int n) {
+    std::vector<std::shared_ptr<QuantumGate>> gates;
+    for (int q = 0; q < n; q++) {
+        gates.push_back(std::make_shared<HadamardGate>(q));
+    }
+    for (int q = 0; q < n; q++) {
+        gates.push_back(std::make_shared<PhaseShiftGate>(q, 0.05 * (q + 1)));
+        gates.push_back(std::make_shared<ControlledPhaseShiftGate>(std::vector<int>{q}, (q + 1) % n, 0.03 * q));
+    }
+    for (int q = 0; q < n; q++) {
+        gates.push_back(std::make_shared<HadamardGate>(q));
+    }
+    return gates;
+}
+
+// |⟨exact|approximate⟩|²
+template <typename Form>
+double fidelity(const QuantumState& exact, const ApproximateState<Form>& approximate) {
+    Complex overlap(0, 0);
+    for (int i = 0; i < exact.getStateSize(); i++) {
+        WideIndex<1> key;
+        key.words[0] = uint64_t(i);
+        overlap += std::conj(exact.getAmplitude(i)) * approximate.getState().getAmplitude(key);
+    }
+    return std::norm(overlap);
+}
+
+template <typename Form>
+void runBoth(const std::vector<std::shared_ptr<QuantumGate>>& gates, QuantumState& exact,
+             ApproximateState<Form>& approximate) {
+    for (const auto& gate : gates) {
+        gate->apply(exact);
+        approximate.apply(*gate);
+    }
+}
+
+void test_fidelity_bound() {
+    printTestHeader("Fixed Threshold and Fidelity Bound");
+
+    const int n = 10;
+    QuantumState exact(n);
+    ApproximateState<SparseState<1>> approximate(n, 0.01);
+    approximate.setThreshold(1e-5);
+    runBoth(spreadCircuit(n), exact, approximate);
+
+    double actual = fidelity(exact, approximate);
+    std::cout << "Nonzeros: " << approximate.getNonzeroCount() << " of " << exact.getStateSize()
+              << ", discarded mass: " << approximate.getDiscardedMass() << std::endl;
+    std::cout << "Fidelity: " << actual << " (bound " << approximate.getFidelityBound() << ")" << std::endl;
+    assert(approximate.getPruneCount() > 0 && approximate.getDiscardedMass() > 0.0);
+    assert(approximate.getNonzeroCount() < size_t(exact.getStateSize()));
+    assert(actual >= approximate.getFidelityBound() - 1e-12 && "Bound must hold");
+    assert(approximate.getFidelityBound() >= 1.0 - 0.01 && "Bound must respect the budget");
+    assert(std::abs(approximate.getState().getNorm() - 1.0) < 1e-12 && "State must be renormalized");
+    std::cout << "✓ Truncated state stays within the error budget" << std::endl;
+}
+
+void test_nonzero_target() {
+    printTestHeader("Auto-Tuned Threshold");
+
+    // A generous budget: the threshold rises until the state fits. The
+    // truncation runs once, after the last gate: halfway through the
+    // Hadamard layers the amplitudes are all equal and none can be dropped
+    // cheaply
+    const int n = 10;
+    const size_t target = 64;
+    std::vector<std::shared_ptr<QuantumGate>> gates = spreadCircuit(n);
+    QuantumState exact(n);
+    ApproximateState<SparseState<1>> loose(n, 0.5, target);
+    loose.setPruneInterval(int(gates.size()));
+    runBoth(gates, exact, loose);
+    std::cout << "Loose budget: " << loose.getNonzeroCount() << " nonzeros, threshold "
+              << loose.getThreshold() << ", fidelity " << fidelity(exact, loose) << std::endl;
+    assert(loose.getNonzeroCount() <= target && !loose.isBudgetLimited());
+    assert(fidelity(exact, loose) >= loose.getFidelityBound() - 1e-12);
+    std::cout << "✓ Threshold tuned to keep " << target << " nonzeros" << std::endl;
+
+    // A tight budget caps the truncation before the target is reached
+    QuantumState exact_tight(n);
+    ApproximateState<SparseState<1>> tight(n, 1e-6, target);
+    tight.setPruneInterval(int(gates.size()));
+    runBoth(gates, exact_tight, tight);
+    assert(tight.isBudgetLimited() && tight.getNonzeroCount() > target);
+    assert(tight.getFidelityBound() >= 1.0 - 1e-6 - 1e-12);
+    assert(fidelity(exact_tight, tight) >= tight.getFidelityBound() - 1e-12);
+    std::cout << "✓ Tight budget keeps " << tight.getNonzeroCount() << " nonzeros, remaining budget "
+              << tight.getRemainingBudget() << std::endl;
+}
+
+void test_sorted_form() {
+    printTestHeader("Sorted Form and Prune Interval");
+
+    const int n = 10;
+    QuantumState exact(n);
+    ApproximateState<SortedSparseState<1>> approximate(n, 0.05);
+    approximate.setThreshold(1e-4);
+    approximate.setPruneInterval(4);
+    std::vector<std::shared_ptr<QuantumGate>> gates = spreadCircuit(n);
+    runBoth(gates, exact, approximate);
+    assert(approximate.getPruneCount() <= int(gates.size() / 4));
+    assert(fidelity(exact, approximate) >= approximate.getFidelityBound() - 1e-12);
+    assert(approximate.getFidelityBound() >= 1.0 - 0.05);
+    std::cout << "✓ Sorted form truncated every 4 gates (" << approximate.getPruneCount()
+              << " truncations)" << std::endl;
+
+    bool threw = false;
+    try {
+        ApproximateState<SparseState<1>> invalid(n, 1.5);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Budget above 1 must be rejected");
+    threw = false;
+    try {
+        approximate.setPruneInterval(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Zero prune interval must be rejected");
+    std::cout << "✓ Invalid budget and interval rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Approximate State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_fidelity_bound();
+        test_nonzero_target();
+        test_sorted_form();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All approximate state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,168 @@
+#include "async_executor.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+double maxDifference(const QuantumState& a, const QuantumState& b) {
+    double difference = 0.0;
+    for (int i = 0; i < a.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(a.getAmplitude(i) - b.getAmplitude(i)));
+    }
+    return difference;
+}
+
+void test_pipeline() {
+    printTestHeader("Pipelined Modular Exponentiation");
+
+    // Period finding for 7 mod 15, gates submitted one at a time
+    const int n = 4;
+    const int m = 4;
+    QuantumState reference(n + m);
+    AsyncExecutor executor{QuantumState(n + m)};
+    Circuit prefix;
+    prefix.add<XGate>(n);
+    for (int q = 0; q < n; q++) {
+        prefix.add<HadamardGate>(q);
+    }
+    prefix.apply(reference);
+    executor.submit(prefix);
+
+    std::future<double> after_hadamards = executor.getProbability(1 << n);
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        ControlledModMultGate gate(q, n, m, multiplier, 15);
+        gate.apply(reference);
+        executor.submit<ControlledModMultGate>(q, n, m, multiplier, 15);
+        multiplier = (multiplier * multiplier) % 15;
+    }
+    std::future<Complex> amplitude = executor.getAmplitude((7 << n) | 1);
+
+    assert(std::abs(after_hadamards.get() - 1.0 / 16) < 1e-12);
+    assert(std::abs(amplitude.get() - reference.getAmplitude((7 << n) | 1)) < 1e-12);
+    std::cout << "✓ Futures see the state as of their submission" << std::endl;
+
+    executor.wait();
+    assert(executor.getGatesSubmitted() == 9 && executor.getGatesExecuted() == 9);
+    QuantumState result = executor.finish();
+    assert(maxDifference(result, reference) < 1e-12);
+    std::cout << "✓ Final state matches synchronous execution" << std::endl;
+
+    bool threw = false;
+    try {
+        executor.submit<XGate>(0);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw && "Submitting after finish() must fail");
+    std::cout << "✓ Submission after finish() rejected" << std::endl;
+}
+
+void test_fusion() {
+    printTestHeader("Lowering and Fusion");
+
+    QuantumState reference(3);
+    Circuit circuit;
+    circuit.add<HadamardGate>(0);
+    circuit.add<PhaseShiftGate>(0, 0.25);
+    circuit.add<PhaseShiftGate>(0, 0.5);
+    circuit.add<HadamardGate>(1);
+    circuit.add<HadamardGate>(1);
+    circuit.add<CNOTGate>(0, 2);
+    circuit.add<CNOTGate>(0, 2);
+    circuit.add<XGate>(2);
+    circuit.apply(reference);
+
+    // Nested circuits are flattened before fusion
+    Circuit outer;
+    outer.add(std::make_shared<Circuit>(circuit));
+
+    AsyncExecutor executor{QuantumState(3)};
+    executor.submit(outer);
+    executor.wait();
+    assert(executor.getGatesSubmitted() == 8);
+    assert(executor.getGatesLowered() == 3 && "Phases merge, H and CNOT pairs cancel");
+    QuantumState result = executor.finish();
+    assert(maxDifference(result, reference) < 1e-12);
+    std::cout << "✓ 8 gates lowered to 3 with the same result" << std::endl;
+
+    // A query between two gates keeps them apart
+    AsyncExecutor separated{QuantumState(1)};
+    separated.submit<XGate>(0);
+    std::future<double> flipped = separated.getProbability(1);
+    separated.submit<XGate>(0);
+    std::future<double> restored = separated.getProbability(1);
+    assert(flipped.get() == 1.0 && restored.get() == 0.0);
+    std::cout << "✓ Queries split fusion at their position" << std::endl;
+}
+
+void test_queries() {
+    printTestHeader("Queries and Sampling");
+
+    AsyncExecutor executor{QuantumState(2)};
+    executor.submit<HadamardGate>(0);
+    executor.submit<CNOTGate>(0, 1);
+    std::future<int> low = executor.sample(0.25);
+    std::future<int> high = executor.sample(0.75);
+    std::future<double> norm = executor.query([](const QuantumState& state) {
+        double total = 0.0;
+        for (int i = 0; i < state.getStateSize(); i++) {
+            total += state.getProbability(i);
+        }
+        return total;
+    });
+    assert(low.get() == 0 && high.get() == 3);
+    assert(std::abs(norm.get() - 1.0) < 1e-12);
+    std::cout << "✓ Bell state samples 00 and 11, custom query computes the norm" << std::endl;
+}
+
+void test_errors() {
+    printTestHeader("Error Propagation");
+
+    AsyncExecutor executor{QuantumState(2)};
+    executor.submit<HadamardGate>(5);  // Beyond the state
+    std::future<double> probability = executor.getProbability(0);
+    bool threw = false;
+    try {
+        probability.get();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Futures after a failed gate must carry its exception");
+
+    threw = false;
+    try {
+        executor.wait();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "wait() must rethrow the gate failure");
+    std::cout << "✓ Gate failure reaches later futures and wait()" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Async Executor Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_pipeline();
+        test_fusion();
+        test_queries();
+        test_errors();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All async executor tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,120 @@
+#include "circuit_dsl.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Helper: largest amplitude difference between two states
+double maxDifference(const QuantumState& a, const QuantumState& b) {
+    double worst = 0.0;
+    for (int i = 0; i < a.getStateSize(); i++) {
+        worst = std::max(worst, std::abs(a.getAmplitude(i) - b.getAmplitude(i)));
+    }
+    return worst;
+}
+
+// Test 1: Bell state and sweep fusion
+void test_dsl_bell_state() {
+    printTestHeader("DSL Bell State Test");
+
+    auto bell = qdsl::H<0>() >> qdsl::CNOT<0, 1>();
+    QuantumState state(2);
+    bell.apply(state);
+
+    std::cout << "P(|00⟩) = " << state.getProbability(0) << ", P(|11⟩) = " << state.getProbability(3) << std::endl;
+    assert(std::abs(state.getProbability(0) - 0.5) < 1e-10 && "Bell state: P(|00⟩) should be 0.5");
+    assert(std::abs(state.getProbability(3) - 0.5) < 1e-10 && "Bell state: P(|11⟩) should be 0.5");
+
+    // Consecutive permutation and phase gates fuse into single sweeps
+    typedef decltype(qdsl::H<0>() >> qdsl::CNOT<0, 1>() >> qdsl::Toffoli<0, 1, 2>() >> qdsl::X<2>()
+                     >> qdsl::S<1>() >> qdsl::T<2>() >> qdsl::H<1>()) Mixed;
+    static_assert(Mixed::length == 7, "Sequence should hold all seven gates");
+    static_assert(Mixed::sweepCount() == 4, "H | CNOT,Toffoli,X | S,T | H should be four sweeps");
+    std::cout << "✓ Bell state and fusion test passed" << std::endl;
+}
+
+// Test 2: DSL circuit matches its runtime Circuit
+void test_dsl_matches_runtime() {
+    printTestHeader("DSL vs Runtime Circuit Test");
+
+    typedef decltype(qdsl::H<0>() >> qdsl::H<1>() >> qdsl::H<2>() >> qdsl::T<0>()
+                     >> qdsl::CNOT<0, 3>() >> qdsl::SWAP<1, 3>() >> qdsl::Toffoli<0, 2, 1>()
+                     >> qdsl::Phase<3, 2, 3>() >> qdsl::H<3>()) Program;
+
+    QuantumState fused(4);
+    Program::apply(fused);
+
+    QuantumState reference(4);
+    Circuit runtime = Program::toCircuit();
+    runtime.apply(reference);
+
+    assert(runtime.size() == Program::length && "Runtime circuit should have one gate per DSL gate");
+    double difference = maxDifference(fused, reference);
+    std::cout << "Max amplitude difference: " << difference << std::endl;
+    assert(difference < 1e-12 && "Fused DSL circuit should match the runtime circuit");
+    std::cout << "✓ DSL matches runtime circuit" << std::endl;
+}
+
+// Test 3: Compile-time adder and comparator match quantum_arithmetic.h
+void test_dsl_arithmetic() {
+    printTestHeader("DSL Arithmetic Test");
+
+    // Adder: a = 5, b = 6 in 3-bit registers, carries at 6..9
+    QuantumState dsl_state(10);
+    dsl_state.setAmplitude(0, Complex(0, 0));
+    dsl_state.setAmplitude(5 | (6 << 3), Complex(1, 0));
+    QuantumState gate_state = dsl_state;
+
+    typedef qdsl::Adder<0, 3, 6, 3> Adder3;
+    static_assert(Adder3::sweepCount() == 1, "Adder is a pure permutation: one sweep");
+    Adder3::apply(dsl_state);
+    QuantumAdder(0, 3, 6, 3).apply(gate_state);
+    assert(maxDifference(dsl_state, gate_state) < 1e-12 && "DSL adder should match QuantumAdder");
+    int b_value = 0;
+    for (int i = 0; i < dsl_state.getStateSize(); i++) {
+        if (dsl_state.getProbability(i) > 0.99) {
+            b_value = (i >> 3) & 7;
+        }
+    }
+    std::cout << "5 + 6 mod 8 = " << b_value << " (expected 3)" << std::endl;
+    assert(b_value == 3 && "Adder result should be 11 mod 8");
+    std::cout << "✓ DSL adder test passed" << std::endl;
+
+    // Comparator on a superposition input
+    QuantumState cmp_dsl(10);
+    for (int q = 0; q < 6; q++) {
+        HadamardGate(q).apply(cmp_dsl);
+    }
+    QuantumState cmp_gate = cmp_dsl;
+    qdsl::Comparator<0, 3, 6, 3>::apply(cmp_dsl);
+    QuantumComparator(0, 3, 6, 3).apply(cmp_gate);
+    assert(maxDifference(cmp_dsl, cmp_gate) < 1e-12 && "DSL comparator should match QuantumComparator");
+    std::cout << "✓ DSL comparator test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Circuit DSL Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_dsl_bell_state();
+        test_dsl_matches_runtime();
+        test_dsl_arithmetic();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All tests passed successfully! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,164 @@
+#include "circuit_jit.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Helper: largest amplitude difference between two states
+double maxDifference(const QuantumState& a, const QuantumState& b) {
+    double worst = 0.0;
+    for (int i = 0; i < a.getStateSize(); i++) {
+        worst = std::max(worst, std::abs(a.getAmplitude(i) - b.getAmplitude(i)));
+    }
+    return worst;
+}
+
+// A circuit mixing every gate kind the JIT translates
+Circuit buildMixedCircuit() {
+    Circuit circuit;
+    for (int q = 0; q < 4; q++) {
+        circuit.add<HadamardGate>(q);
+    }
+    circuit.add<PhaseShiftGate>(1, M_PI / 4);
+    circuit.add<PhaseShiftGate>(3, M_PI / 3);
+    circuit.add<QuantumAdder>(0, 4, 8, 2);  // Composite: expanded into Toffolis and CNOTs
+    circuit.add<SWAPGate>(0, 7);
+    circuit.add<XGate>(2);
+    circuit.add<ControlledModMultGate>(1, 4, 4, 7, 15);
+    circuit.add<HadamardGate>(5);
+    return circuit;
+}
+
+// Test 1: Compiled kernel matches the interpreter
+void test_jit_matches_interpreter() {
+    printTestHeader("JIT vs Interpreter Test");
+
+    Circuit circuit = buildMixedCircuit();
+    CircuitJit jit(circuit);
+
+    QuantumState expected(11);
+    circuit.apply(expected);
+
+    QuantumState actual(11);
+    jit.apply(actual);
+
+    if (!jit.isCompiled(11)) {
+        // No compiler in this environment: the interpreter fallback was used
+        std::cout << "JIT unavailable (" << jit.getLastError() << "), checked fallback only" << std::endl;
+    }
+    double difference = maxDifference(expected, actual);
+    std::cout << "Max amplitude difference: " << difference << std::endl;
+    assert(difference < 1e-12 && "JIT result should match the interpreter");
+    std::cout << "✓ JIT matches interpreter" << std::endl;
+
+    // Second application reuses the loaded kernel
+    circuit.apply(expected);
+    jit.apply(actual);
+    assert(maxDifference(expected, actual) < 1e-12 && "Repeated JIT runs should match");
+    std::cout << "✓ Repeated execution test passed" << std::endl;
+}
+
+// Test 2: Missing compiler falls back to the interpreter
+void test_jit_fallback() {
+    printTestHeader("JIT Fallback Test");
+
+    setenv("QJIT_CXX", "/nonexistent/compiler", 1);
+    Circuit circuit;
+    circuit.add<HadamardGate>(0);
+    circuit.add<CNOTGate>(0, 1);
+    circuit.add<PhaseShiftGate>(1, 0.123456789);  // Unique constant: not in the disk cache
+    CircuitJit jit(circuit);
+
+    QuantumState state(2);
+    jit.apply(state);
+    unsetenv("QJIT_CXX");
+
+    std::cout << "Compiled: " << (jit.isCompiled(2) ? "yes" : "no")
+              << " (" << jit.getLastError() << ")" << std::endl;
+    assert(!jit.isCompiled(2) && "Kernel must not compile without a compiler");
+    assert(std::abs(state.getProbability(0) - 0.5) < 1e-10 && "Fallback should produce a Bell state");
+    assert(std::abs(state.getProbability(3) - 0.5) < 1e-10 && "Fallback should produce a Bell state");
+    std::cout << "✓ Interpreter fallback test passed" << std::endl;
+}
+
+// Test 3: The disk cache is only trusted when private and matching
+void test_jit_cache_safety() {
+    printTestHeader("JIT Cache Safety Test");
+
+    // A directory name with a quote and a space must not break compilation
+    std::filesystem::path root = std::filesystem::temp_directory_path() / ("qjit-test-" + std::to_string(getpid()));
+    std::string directory = (root / "it's cached").string();
+    Circuit circuit;
+    circuit.add<HadamardGate>(0);
+    circuit.add<PhaseShiftGate>(0, 0.987654321);
+    QuantumState expected(1);
+    circuit.apply(expected);
+
+    CircuitJit jit(circuit, directory);
+    if (!jit.compile(1)) {
+        std::cout << "JIT unavailable (" << jit.getLastError() << "), skipped" << std::endl;
+        std::filesystem::remove_all(root);
+        return;
+    }
+    auto permissions = std::filesystem::status(directory).permissions();
+    assert((permissions & std::filesystem::perms::all) == std::filesystem::perms::owner_all);
+    std::cout << "✓ Compiled into a new 0700 directory whose name contains a quote" << std::endl;
+
+    // Saved source no longer matches: the library is not loaded
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".cpp") {
+            std::ofstream(entry.path(), std::ios::app) << "// edited\n";
+        }
+    }
+    CircuitJit mismatched(circuit, directory);
+    QuantumState state(1);
+    mismatched.apply(state);
+    std::cout << "Edited source: " << mismatched.getLastError() << std::endl;
+    assert(!mismatched.isCompiled(1) && maxDifference(state, expected) < 1e-12);
+    std::cout << "✓ Cached library with different source is not loaded" << std::endl;
+
+    // A directory others can write to is refused
+    std::filesystem::permissions(directory, std::filesystem::perms::all);
+    CircuitJit shared(circuit, directory);
+    QuantumState fallback(1);
+    shared.apply(fallback);
+    std::cout << "World-writable directory: " << shared.getLastError() << std::endl;
+    assert(!shared.isCompiled(1) && maxDifference(fallback, expected) < 1e-12);
+    std::cout << "✓ World-writable cache directory is refused" << std::endl;
+
+    std::filesystem::remove_all(root);
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Circuit JIT Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_jit_matches_interpreter();
+        test_jit_fallback();
+        test_jit_cache_safety();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All tests passed successfully! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,99 @@
+#include "complex_math.h"
+#include "quantum_gates.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+void test_against_std_complex() {
+    printTestHeader("Helpers vs std::complex");
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> value(-2.0, 2.0);
+    double difference = 0.0;
+    for (int k = 0; k < 1000; k++) {
+        Complex a(value(rng), value(rng));
+        Complex b(value(rng), value(rng));
+        Complex c(value(rng), value(rng));
+        difference = std::max(difference, std::abs(complexMul(a, b) - a * b));
+        difference = std::max(difference, std::abs(complexMulConj(a, b) - std::conj(a) * b));
+        difference = std::max(difference, std::abs(complexFma(c, a, b) - (c + a * b)));
+        difference = std::max(difference, std::abs(complexNorm(a) - std::norm(a)));
+    }
+    std::cout << "Max difference: " << difference << std::endl;
+    assert(difference < 1e-14 && "Helpers must match std::complex for finite values");
+    std::cout << "✓ mul, conj-mul, fma and norm match std::complex" << std::endl;
+
+    std::vector<Complex> run(37);
+    std::vector<Complex> expected(run.size());
+    Complex factor(std::cos(0.7), std::sin(0.7));
+    for (size_t k = 0; k < run.size(); k++) {
+        run[k] = Complex(value(rng), value(rng));
+        expected[k] = run[k] * factor;
+    }
+    complexScale(run.data(), run.size(), factor);
+    for (size_t k = 0; k < run.size(); k++) {
+        assert(std::abs(run[k] - expected[k]) < 1e-14);
+    }
+    std::cout << "✓ complexScale multiplies a run in place" << std::endl;
+}
+
+void test_phase_kernels() {
+    printTestHeader("Phase Kernels");
+
+    // Uniform superposition, then one phase per qubit position, checked
+    // against the closed form amplitude
+    const int n = 6;
+    QuantumState state(n);
+    for (int q = 0; q < n; q++) {
+        HadamardGate h(q);
+        h.apply(state);
+    }
+    for (int q = 0; q < n; q++) {
+        PhaseShiftGate phase(q, 0.1 * (q + 1));
+        phase.apply(state);
+    }
+    ControlledPhaseShiftGate controlled(std::vector<int>{0, 5}, 3, 0.9);
+    controlled.apply(state);
+
+    double amplitude = 1.0 / std::sqrt(double(state.getStateSize()));
+    for (int i = 0; i < state.getStateSize(); i++) {
+        double angle = 0.0;
+        for (int q = 0; q < n; q++) {
+            if ((i >> q) & 1) {
+                angle += 0.1 * (q + 1);
+            }
+        }
+        if ((i & 0x29) == 0x29) {
+            angle += 0.9;
+        }
+        assert(std::abs(state.getAmplitude(i) - std::polar(amplitude, angle)) < 1e-14);
+    }
+    std::cout << "✓ PhaseShift and controlled phase match the closed form" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Complex Math Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_against_std_complex();
+        test_phase_kernels();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All complex math tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,120 @@
+#include "quantum_gates.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Distinct amplitudes, so any misplaced entry shows up
+void fillDistinct(QuantumState& state) {
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, Complex(std::cos(0.37 * i), std::sin(0.11 * i)));
+    }
+}
+
+bool sameState(const QuantumState& a, const QuantumState& b) {
+    for (int i = 0; i < a.getStateSize(); i++) {
+        if (a.getAmplitude(i) != b.getAmplitude(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Apply a gate in place and double-buffered, compare exactly
+void checkGate(QuantumGate&& gate, int num_qubits, const std::string& name) {
+    QuantumState in_place(num_qubits);
+    fillDistinct(in_place);
+    QuantumState buffered(in_place);
+    buffered.setDoubleBuffered(true);
+    gate.apply(in_place);
+    gate.apply(buffered);
+    assert(sameState(in_place, buffered) && "Double-buffered result must match in-place result");
+    std::cout << "✓ " << name << " matches the in-place kernel" << std::endl;
+}
+
+void test_gates() {
+    printTestHeader("Out-of-Place Kernels");
+
+    checkGate(ControlledModMultGate(0, 3, 4, 7, 15), 8, "ControlledModMultGate");
+    checkGate(ControlledModMultGate(7, 0, 4, 6, 15), 8, "ControlledModMultGate (non-coprime fallback)");
+    checkGate(LookupModMultGate(0, 3, 3, 5, {1, 2, 4, 8, 16, 32, 31, 29}, 33), 9, "LookupModMultGate");
+    checkGate(RegisterSwapGate(0, 4, 3), 8, "RegisterSwapGate");
+    checkGate(ControlledRegisterSwapGate(7, 0, 3, 3), 8, "ControlledRegisterSwapGate");
+    checkGate(QuantumAdder(0, 3, 6, 3, EMULATED), 10, "QuantumAdder (emulated)");
+}
+
+void test_buffers() {
+    printTestHeader("Buffer Management");
+
+    QuantumState state(10);
+    size_t single = state.getMemoryUsage();
+    state.setDoubleBuffered(true);
+    assert(state.isDoubleBuffered() && state.getMemoryUsage() == 2 * single);
+    std::cout << "✓ Double buffering doubles the memory use" << std::endl;
+
+    // Copies keep the mode but allocate their back buffer on first use
+    QuantumState copy(state);
+    assert(copy.isDoubleBuffered() && copy.getMemoryUsage() == single);
+    ControlledModMultGate(0, 1, 4, 7, 15).apply(copy);
+    assert(copy.getMemoryUsage() == 2 * single);
+    QuantumState branch = state.fork();
+    assert(!branch.isDoubleBuffered() && branch.getMemoryUsage() == single);
+    std::cout << "✓ Copies allocate the back buffer lazily, forks are single-buffered" << std::endl;
+
+    state.setDoubleBuffered(false);
+    assert(state.getMemoryUsage() == single);
+    std::cout << "✓ Disabling releases the back buffer" << std::endl;
+}
+
+void test_streaming() {
+    printTestHeader("Streaming Stores on a Large State");
+
+    // 2^21 amplitudes = 32 MB, above the streaming threshold
+    const int n = 21;
+    QuantumState in_place(n);
+    fillDistinct(in_place);
+    QuantumState buffered(in_place);
+    buffered.setDoubleBuffered(true);
+
+    typedef std::chrono::steady_clock Clock;
+    ControlledModMultGate gate(0, 11, 10, 3, 1021);
+    Clock::time_point start = Clock::now();
+    gate.apply(in_place);
+    double in_place_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    gate.apply(buffered);
+    double buffered_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    assert(sameState(in_place, buffered));
+    std::cout << "In place: " << in_place_seconds << " s, double-buffered: " << buffered_seconds << " s"
+              << std::endl;
+    std::cout << "✓ Streaming gather matches the in-place kernel" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Double Buffering Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_gates();
+        test_buffers();
+        test_streaming();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All double buffering tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
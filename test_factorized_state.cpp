@@ -0,0 +1,163 @@
+#include "factorized_state.h"
+#include "quantum_arithmetic.h"
+#include "quantum_grover.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Apply the same gate to the dense reference and the factorized state
+void applyBoth(QuantumGate&& gate, QuantumState& dense, FactorizedState& factorized) {
+    gate.apply(dense);
+    factorized.apply(gate);
+}
+
+double maxDifference(const QuantumState& dense, const FactorizedState& factorized) {
+    QuantumState expanded = factorized.toDense();
+    double difference = 0.0;
+    for (int i = 0; i < dense.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - expanded.getAmplitude(i)));
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - factorized.getAmplitude(i)));
+    }
+    return difference;
+}
+
+void test_product_gates() {
+    printTestHeader("Single-Qubit Gates Stay Factorized");
+
+    const int n = 6;
+    QuantumState dense(n);
+    FactorizedState factorized(n);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, factorized);
+        applyBoth(PhaseShiftGate(q, 0.3 * (q + 1)), dense, factorized);
+        if (q % 2 == 1) {
+            applyBoth(XGate(q), dense, factorized);
+        }
+    }
+    assert(factorized.getFactorCount() == n && "Single-qubit gates must not merge factors");
+    assert(factorized.getMergeCount() == 0);
+    assert(maxDifference(dense, factorized) < 1e-12 && "Product state must match the dense state");
+    std::cout << "✓ " << n << " factors, " << factorized.getMemoryUsage() << " bytes instead of "
+              << dense.getMemoryUsage() << std::endl;
+}
+
+void test_entangling_gates() {
+    printTestHeader("Entangling Gates Merge Lazily");
+
+    const int n = 7;
+    QuantumState dense(n);
+    FactorizedState factorized(n);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, factorized);
+        applyBoth(PhaseShiftGate(q, 0.2 + 0.1 * q), dense, factorized);
+    }
+
+    // A SWAP across factors only exchanges labels
+    applyBoth(SWAPGate(1, 5), dense, factorized);
+    assert(factorized.getFactorCount() == n && "Cross-factor SWAP must not merge");
+
+    applyBoth(CNOTGate(0, 3), dense, factorized);
+    assert(factorized.getFactorCount() == n - 1);
+    applyBoth(ToffoliGate(3, 6, 2), dense, factorized);
+    assert(factorized.getFactorCount() == n - 3);
+    assert(factorized.getLargestFactor() == 4);
+    applyBoth(SWAPGate(0, 4), dense, factorized);
+    applyBoth(ControlledPhaseShiftGate(std::vector<int>{1, 2}, 6, 0.7), dense, factorized);
+    std::cout << "Factors after CNOT, Toffoli, CPHASE: " << factorized.getFactorCount()
+              << " (largest " << factorized.getLargestFactor() << " qubits)" << std::endl;
+
+    // Register gates are re-targeted to local qubits of the merged factor
+    applyBoth(RegisterSwapGate(0, 3, 2), dense, factorized);
+    applyBoth(ControlledRegisterSwapGate(6, 0, 2, 2), dense, factorized);
+    applyBoth(ControlledModMultGate(6, 0, 3, 3, 7), dense, factorized);
+
+    // Composite gates are expanded through decompose()
+    applyBoth(QFTGate(1, 4), dense, factorized);
+
+    double difference = maxDifference(dense, factorized);
+    std::cout << "Max difference to dense: " << difference << std::endl;
+    assert(difference < 1e-12 && "Factorized state must match the dense state");
+    std::cout << "✓ Matches dense simulation after " << factorized.getMergeCount() << " merges" << std::endl;
+
+    // A gate without footprint or decomposition merges everything
+    applyBoth(DiffusionGate(2, 3), dense, factorized);
+    assert(factorized.getFactorCount() == 1 && "Opaque gate must fall back to one factor");
+    assert(maxDifference(dense, factorized) < 1e-12);
+    std::cout << "✓ Opaque gate falls back to a single dense factor" << std::endl;
+}
+
+void test_modular_exponentiation() {
+    printTestHeader("Modular Exponentiation: Factorized vs Dense");
+
+    // 7^x mod 15 with a 4-qubit exponent, as in main
+    const int n = 4;
+    const int m = 4;
+    const uint64_t modulus = 15;
+    QuantumState dense(n + m);
+    FactorizedState factorized(n + m);
+    applyBoth(XGate(n), dense, factorized);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, factorized);
+    }
+    size_t prefix_bytes = factorized.getMemoryUsage();
+    assert(factorized.getFactorCount() == n + m && "Hadamard prefix must stay a product");
+
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        applyBoth(ControlledModMultGate(q, n, m, multiplier, modulus), dense, factorized);
+        std::cout << "After U^(2^" << q << "): largest factor " << factorized.getLargestFactor() << " qubits"
+                  << std::endl;
+        multiplier = (multiplier * multiplier) % modulus;
+    }
+    assert(maxDifference(dense, factorized) < 1e-12 && "Modular exponentiation must match dense");
+    std::cout << "✓ Prefix held in " << prefix_bytes << " bytes; final state matches dense" << std::endl;
+
+    // Windowed variant: one lookup gate over all exponent qubits
+    FactorizedState windowed(n + m);
+    XGate x(n);
+    windowed.apply(x);
+    for (int q = 0; q < n; q++) {
+        HadamardGate h(q);
+        windowed.apply(h);
+    }
+    std::vector<uint64_t> table(size_t(1) << n, 1);
+    for (size_t k = 1; k < table.size(); k++) {
+        table[k] = (table[k - 1] * 7) % modulus;
+    }
+    LookupModMultGate lookup(0, n, n, m, table, modulus);
+    windowed.apply(lookup);
+    QuantumState expected = factorized.toDense();
+    QuantumState actual = windowed.toDense();
+    for (int i = 0; i < expected.getStateSize(); i++) {
+        assert(std::abs(expected.getAmplitude(i) - actual.getAmplitude(i)) < 1e-12 &&
+               "Lookup multiplication must match the per-qubit multiplications");
+    }
+    std::cout << "✓ Lookup multiplication merges into one factor and matches" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Factorized State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_product_gates();
+        test_entangling_gates();
+        test_modular_exponentiation();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All factorized state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
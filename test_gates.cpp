@@ -2,6 +2,9 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <fstream>
+#include <set>
+#include <sstream>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -113,6 +116,44 @@ void test_swap() {
     std::cout << "✓ SWAP|00⟩ test passed" << std::endl;
 }
 
+// Register swaps must match their qubit-by-qubit decompositions
+void test_register_swap() {
+    printTestHeader("Register SWAP Gate Test");
+
+    // Distinct amplitudes on 7 qubits so any misplaced entry is caught
+    QuantumState initial(7);
+    for (int i = 0; i < initial.getStateSize(); i++) {
+        initial.setAmplitude(i, Complex(i + 1, -i));
+    }
+
+    std::vector<std::shared_ptr<QuantumGate>> gates = {
+        std::make_shared<RegisterSwapGate>(0, 4, 3),
+        std::make_shared<ControlledRegisterSwapGate>(3, 0, 4, 3),
+        std::make_shared<ControlledRegisterSwapGate>(0, 5, 1, 2)
+    };
+    for (const auto& gate : gates) {
+        QuantumState fused = initial;
+        QuantumState reference = initial;
+        gate->apply(fused);
+        for (const auto& part : gate->decompose()) {
+            part->apply(reference);
+        }
+        for (int i = 0; i < fused.getStateSize(); i++) {
+            assert(fused.getAmplitude(i) == reference.getAmplitude(i) && "Register swap mismatch");
+        }
+        std::cout << "✓ " << gate->describe() << " matches " << gate->decompose().size() << " gates" << std::endl;
+    }
+
+    // |c=1, a=5, b=2⟩ → |c=1, a=2, b=5⟩ on layout c=3, a=0-2, b=4-6
+    QuantumState state(7);
+    int input = (1 << 3) | 5 | (2 << 4);
+    state.setAmplitude(0, Complex(0, 0));
+    state.setAmplitude(input, Complex(1, 0));
+    ControlledRegisterSwapGate(3, 0, 4, 3).apply(state);
+    assert(std::abs(state.getProbability((1 << 3) | 2 | (5 << 4)) - 1.0) < 1e-10 && "Controlled swap failed");
+    std::cout << "✓ |1⟩|5⟩|2⟩ → |1⟩|2⟩|5⟩" << std::endl;
+}
+
 // Test 4: Toffoli Gate
 void test_toffoli() {
     printTestHeader("Toffoli Gate Test");
@@ -203,7 +244,34 @@ void test_phase_shift() {
     std::cout << "✓ Phase gate leaves |0⟩ unchanged" << std::endl;
 }
 
-// Test 6: Gate Composition (Bell State)
+// Test 6: Controlled Phase Shift Gate
+void test_controlled_phase_shift() {
+    printTestHeader("Controlled Phase Shift Gate Test");
+
+    // Uniform superposition over 2 qubits: only |11⟩ picks up the phase
+    QuantumState state(2);
+    for (int i = 0; i < 4; i++) {
+        state.setAmplitude(i, Complex(0.5, 0));
+    }
+    ControlledPhaseShiftGate CZ_gate(0, 1, M_PI);
+    CZ_gate.apply(state);
+    for (int i = 0; i < 3; i++) {
+        assert(std::abs(state.getAmplitude(i) - Complex(0.5, 0)) < 1e-10 && "Only |11⟩ should change");
+    }
+    assert(std::abs(state.getAmplitude(3) - Complex(-0.5, 0)) < 1e-10 && "|11⟩ should pick up -1");
+    std::cout << "✓ Controlled-Z flips the sign of |11⟩ only" << std::endl;
+
+    // Two controls: phase only on |111⟩
+    QuantumState state2(3);
+    state2.setAmplitude(0, Complex(0, 0));
+    state2.setAmplitude(7, Complex(1, 0));
+    ControlledPhaseShiftGate CCS_gate(std::vector<int>{0, 1}, 2, M_PI / 2);
+    CCS_gate.apply(state2);
+    assert(std::abs(state2.getAmplitude(7) - Complex(0, 1)) < 1e-10 && "|111⟩ should pick up i");
+    std::cout << "✓ Doubly-controlled S gives |111⟩ → i|111⟩" << std::endl;
+}
+
+// Test 7: Gate Composition (Bell State)
 void test_bell_state() {
     printTestHeader("Bell State Creation Test");
 
@@ -233,6 +301,121 @@ void test_bell_state() {
     std::cout << "✓ Bell state creation test passed" << std::endl;
 }
 
+// Test 8: Copy-on-write state fork
+void test_state_fork() {
+    printTestHeader("State Fork Test");
+
+    // 14 qubits (256 KB) is large enough to use the shared-page path
+    int num_qubits = 14;
+    QuantumState parent(num_qubits);
+    for (int q = 0; q < num_qubits; q++) {
+        HadamardGate H(q);
+        H.apply(parent);
+    }
+
+    QuantumState branch = parent.fork();
+    assert(branch.getNumQubits() == num_qubits && "Fork should keep the qubit count");
+    for (int i = 0; i < parent.getStateSize(); i++) {
+        assert(branch.getAmplitude(i) == parent.getAmplitude(i) && "Fork should start identical");
+    }
+    std::cout << "✓ Fork starts identical to parent" << std::endl;
+
+    // The amplitude buffer still converts to a plain vector
+    std::vector<Complex> copied = branch.getAmplitudes();
+    assert(copied.size() == size_t(branch.getStateSize()) && copied[1] == branch.getAmplitude(1));
+
+    // Modify each side differently; the other side must not see the change
+    PhaseShiftGate Z_gate(num_qubits - 1, M_PI);
+    Z_gate.apply(branch);
+    XGate X(0);
+    X.apply(parent);
+    parent.setAmplitude(0, Complex(0.5, 0));
+
+    int last = parent.getStateSize() - 1;
+    double uniform = 1.0 / std::sqrt(double(parent.getStateSize()));
+    std::cout << "Parent |0⟩ = " << parent.getAmplitude(0) << ", branch |0⟩ = " << branch.getAmplitude(0) << std::endl;
+    assert(std::abs(branch.getAmplitude(0).real() - uniform) < 1e-12 && "Parent write leaked into branch");
+    assert(std::abs(branch.getAmplitude(last).real() + uniform) < 1e-12 && "Branch should see its own phase flip");
+    assert(std::abs(parent.getAmplitude(last).real() - uniform) < 1e-12 && "Branch write leaked into parent");
+    assert(branch.isNormalized() && "Branch should stay normalized");
+    std::cout << "✓ Parent and branch diverge independently" << std::endl;
+
+    // Forks of small states fall back to plain copies
+    QuantumState small(2);
+    QuantumState small_fork = small.fork();
+    small_fork.setAmplitude(0, Complex(0, 0));
+    assert(std::abs(small.getProbability(0) - 1.0) < 1e-10 && "Small fork must not alias");
+    std::cout << "✓ Small state fork test passed" << std::endl;
+}
+
+// Distinct memory files backing forked states (Linux), and the system's
+// shared memory in KB
+std::set<std::string> forkBackingFiles() {
+    std::set<std::string> inodes;
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        if (line.find("memfd:quantum_state") != std::string::npos) {
+            std::istringstream fields(line);
+            std::string range, perms, offset, device, inode;
+            fields >> range >> perms >> offset >> device >> inode;
+            inodes.insert(inode);
+        }
+    }
+    return inodes;
+}
+
+long sharedMemoryKB() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    long value = 0;
+    while (meminfo >> key >> value) {
+        if (key == "Shmem:") {
+            return value;
+        }
+        meminfo.ignore(256, '\n');
+    }
+    return 0;
+}
+
+// Test 9: Sibling forks share one copy of the parent
+void test_fork_siblings() {
+    printTestHeader("Sibling Fork Test");
+
+#ifdef __linux__
+    // 20 qubits = 16 MB per state
+    int num_qubits = 20;
+    QuantumState parent(num_qubits);
+    for (int q = 0; q < num_qubits; q++) {
+        HadamardGate(q).apply(parent);
+    }
+    long state_kb = long(parent.getMemoryUsage() / 1024);
+    long shmem_before = sharedMemoryKB();
+    std::vector<QuantumState> siblings;
+    for (int k = 0; k < 8; k++) {
+        siblings.push_back(parent.fork());
+    }
+    long shmem_grown = sharedMemoryKB() - shmem_before;
+    std::cout << "8 forks of a " << state_kb << " KB state: " << forkBackingFiles().size()
+              << " backing file(s), shared memory +" << shmem_grown << " KB" << std::endl;
+    assert(forkBackingFiles().size() == 1 && "Siblings must map the same backing file");
+    assert(shmem_grown < 4 * state_kb && "Siblings must not each hold a full copy");
+    std::cout << "✓ Eight siblings share one copy" << std::endl;
+
+    // A branch that wrote pages gets a new file when forked; the parent,
+    // still unmodified, keeps sharing the old one
+    PhaseShiftGate(0, M_PI).apply(siblings[0]);
+    QuantumState grandchild = siblings[0].fork();
+    QuantumState late_sibling = parent.fork();
+    assert(forkBackingFiles().size() == 2);
+    assert(grandchild.getAmplitude(1) == siblings[0].getAmplitude(1) && grandchild.getAmplitude(1).real() < 0);
+    assert(late_sibling.getAmplitude(1) == parent.getAmplitude(1) && parent.getAmplitude(1).real() > 0);
+    std::cout << "✓ Fork of a modified branch sees its writes, parent forks still shared" << std::endl;
+#else
+    std::cout << "Shared forks need Linux, skipped" << std::endl;
+#endif
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "   Quantum Gates Test Suite" << std::endl;
@@ -242,9 +425,13 @@ int main() {
         test_hadamard();
         test_cnot();
         test_swap();
+        test_register_swap();
         test_toffoli();
         test_phase_shift();
+        test_controlled_phase_shift();
         test_bell_state();
+        test_state_fork();
+        test_fork_siblings();
 
         std::cout << "\n========================================" << std::endl;
         std::cout << "   All tests passed successfully! ✓" << std::endl;
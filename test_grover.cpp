@@ -0,0 +1,113 @@
+#include "quantum_grover.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+QuantumState randomState(int num_qubits, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    QuantumState state(num_qubits);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, Complex(gaussian(rng), gaussian(rng)));
+    }
+    return state;
+}
+
+double maxDifference(const QuantumState& a, const QuantumState& b, double b_factor = 1.0) {
+    double difference = 0.0;
+    for (int i = 0; i < a.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(a.getAmplitude(i) - b_factor * b.getAmplitude(i)));
+    }
+    return difference;
+}
+
+void test_diffusion_gate() {
+    printTestHeader("Diffusion Gate vs H-X-MCZ-X-H");
+
+    // Register 1-3 of a 5-qubit state: 4 independent blocks
+    const int start = 1;
+    const int count = 3;
+    QuantumState initial = randomState(5, 11);
+
+    QuantumState fused = initial;
+    DiffusionGate(start, count).apply(fused);
+
+    QuantumState chain = initial;
+    for (int q = start; q < start + count; q++) HadamardGate(q).apply(chain);
+    for (int q = start; q < start + count; q++) XGate(q).apply(chain);
+    ControlledPhaseShiftGate(std::vector<int>{start, start + 1}, start + 2, M_PI).apply(chain);
+    for (int q = start; q < start + count; q++) XGate(q).apply(chain);
+    for (int q = start; q < start + count; q++) HadamardGate(q).apply(chain);
+
+    // The gate chain differs from 2|s⟩⟨s| - I by a global phase of -1
+    double difference = maxDifference(fused, chain, -1.0);
+    std::cout << "Max difference (up to global phase): " << difference << std::endl;
+    assert(difference < 1e-12 && "Diffusion gate must match the gate chain");
+    std::cout << "✓ Per-block inversion about the mean matches 4n+1 gate sweeps" << std::endl;
+
+    // Full-state register takes the reduction path
+    QuantumState full = randomState(4, 12);
+    QuantumState original = full;
+    DiffusionGate(0, 4).apply(full);
+    DiffusionGate(0, 4).apply(full);
+    assert(maxDifference(full, original) < 1e-12 && "Diffusion must be an involution");
+    std::cout << "✓ Full-register diffusion is its own inverse" << std::endl;
+}
+
+void test_grover_search() {
+    printTestHeader("Grover Search");
+
+    // Find x = 173 among 256 values
+    const int count = 8;
+    const uint64_t target = 173;
+    auto marked = [=](uint64_t x) { return x == target; };
+    int iterations = groverIterations(count, 1);
+
+    QuantumState state(count);
+    for (int q = 0; q < count; q++) {
+        HadamardGate(q).apply(state);
+    }
+    QuantumState unfused = state;
+
+    GroverSearch<decltype(marked)> search(0, count, marked, iterations);
+    search.apply(state);
+    double probability = state.getProbability(int(target));
+    std::cout << iterations << " iterations: P(" << target << ") = " << probability << std::endl;
+    assert(probability > 0.99 && "Grover search should find the marked value");
+    std::cout << "✓ Marked value found with high probability" << std::endl;
+
+    // Fused iterations match the separate oracle and diffusion gates
+    for (const auto& gate : search.decompose()) {
+        gate->apply(unfused);
+    }
+    double difference = maxDifference(state, unfused);
+    assert(difference < 1e-12 && "Fused Grover iterations must match the unfused gates");
+    std::cout << "✓ Fused iterations match " << search.decompose().size() << " separate gates" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Grover Search Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_diffusion_gate();
+        test_grover_search();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All Grover tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
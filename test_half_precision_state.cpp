@@ -0,0 +1,135 @@
+#include "half_precision_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+void test_conversions() {
+    printTestHeader("16-bit Conversions");
+
+    // Every finite fp16 value survives a round trip through float
+    for (uint32_t h = 0; h < 0x10000; h++) {
+        if ((h & 0x7C00) == 0x7C00) {
+            continue;  // Inf and NaN
+        }
+        assert(Float16Format::fromFloat(Float16Format::toFloat(uint16_t(h))) == h);
+    }
+    assert(Float16Format::fromFloat(1.0f) == 0x3C00);
+    assert(Float16Format::fromFloat(65504.0f) == 0x7BFF);
+    assert(Float16Format::fromFloat(1e6f) == 0x7C00 && "Overflow must give Inf");
+    assert(Float16Format::fromFloat(1.0f + 1.0f / 2048) == 0x3C00 && "Ties round to even");
+    assert(Float16Format::fromFloat(1.0f + 3.0f / 2048) == 0x3C02 && "Ties round to even");
+    assert(Float16Format::fromFloat(1e-7f) == 0x0002 && "Subnormals round to nearest");
+    std::cout << "✓ fp16 round trips, rounding, overflow and subnormals" << std::endl;
+
+    assert(BFloat16Format::fromFloat(1.0f) == 0x3F80);
+    assert(BFloat16Format::toFloat(BFloat16Format::fromFloat(3.0f)) == 3.0f);
+    assert(BFloat16Format::fromFloat(1.0f + 1.0f / 256) == 0x3F80 && "Ties round to even");
+    assert(std::abs(BFloat16Format::toFloat(BFloat16Format::fromFloat(0.1f)) - 0.1f) < 0.1f / 256);
+    std::cout << "✓ bf16 rounding" << std::endl;
+}
+
+// Period-finding circuit on the double reference and the 16-bit state
+template <typename Format>
+void runCircuit(QuantumState& dense, HalfPrecisionState<Format>& half) {
+    const int n = 4;
+    const int m = 4;
+    std::vector<std::shared_ptr<QuantumGate>> gates;
+    gates.push_back(std::make_shared<XGate>(n));
+    for (int q = 0; q < n; q++) {
+        gates.push_back(std::make_shared<HadamardGate>(q));
+    }
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        gates.push_back(std::make_shared<ControlledModMultGate>(q, n, m, multiplier, 15));
+        multiplier = (multiplier * multiplier) % 15;
+    }
+    // Irrational phases, so amplitudes are not exactly representable
+    gates.push_back(std::make_shared<PhaseShiftGate>(1, 0.3));
+    gates.push_back(std::make_shared<ControlledPhaseShiftGate>(std::vector<int>{0, 5}, 3, 1.1));
+    gates.push_back(std::make_shared<QFTGate>(0, n));
+    for (int q = n; q < n + m; q++) {
+        gates.push_back(std::make_shared<HadamardGate>(q));
+    }
+    for (const auto& gate : gates) {
+        gate->apply(dense);
+        half.apply(*gate);
+    }
+}
+
+void test_against_double() {
+    printTestHeader("Accuracy Against Double");
+
+    QuantumState reference(8);
+    Float16State fp16(8);
+    runCircuit(reference, fp16);
+    double fp16_error = fp16.getMaxError(reference);
+    std::cout << "fp16: max error " << fp16_error << ", estimate " << fp16.getErrorEstimate()
+              << ", " << fp16.getMemoryUsage() << " bytes" << std::endl;
+    assert(fp16_error < 2e-3 && fp16_error <= fp16.getErrorEstimate());
+    assert(fp16.getMemoryUsage() * 4 == reference.getMemoryUsage());
+
+    QuantumState reference_bf16(8);
+    BFloat16State bf16(8);
+    runCircuit(reference_bf16, bf16);
+    double bf16_error = bf16.getMaxError(reference_bf16);
+    std::cout << "bf16: max error " << bf16_error << ", estimate " << bf16.getErrorEstimate() << std::endl;
+    assert(bf16_error < 2e-2 && bf16_error <= bf16.getErrorEstimate());
+    std::cout << "✓ 16-bit storage stays within its error estimate at a quarter of the memory" << std::endl;
+
+    // Uniform superposition: stored as 1 through the storage scale, read
+    // back as 2^-8 at full fp16 relative precision
+    const int n = 16;
+    Float16State uniform(n);
+    for (int q = 0; q < n; q++) {
+        HadamardGate h(q);
+        uniform.apply(h);
+    }
+    double expected = 1.0 / 256;
+    assert(std::abs(uniform.getAmplitude(12345).real() - expected) < expected * 1e-3);
+    assert(std::abs(uniform.getNorm() - 1.0) < 1e-2);
+    std::cout << "✓ Small amplitudes keep full fp16 relative precision" << std::endl;
+
+    // Multiplying by 2 mod 4 is not a permutation: rejected up front
+    Float16State merged(3);
+    XGate x0(0);
+    XGate x1(1);
+    merged.apply(x0);
+    merged.apply(x1);
+    ControlledModMultGate non_coprime(0, 1, 2, 2, 4);
+    bool threw = false;
+    try {
+        merged.apply(non_coprime);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Non-invertible multiplier must be rejected");
+    assert(std::abs(merged.getAmplitude(3).real() - 1.0) < 1e-3 && "Rejected gate must leave the state as it was");
+    std::cout << "✓ Non-invertible multiplier rejected, state unchanged" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Half-Precision State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_conversions();
+        test_against_double();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All half-precision state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
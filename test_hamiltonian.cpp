@@ -0,0 +1,151 @@
+#include "quantum_hamiltonian.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+QuantumState randomState(int num_qubits, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    QuantumState state(num_qubits);
+    double norm = 0.0;
+    for (int i = 0; i < state.getStateSize(); i++) {
+        Complex amp(gaussian(rng), gaussian(rng));
+        state.setAmplitude(i, amp);
+        norm += std::norm(amp);
+    }
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, state.getAmplitude(i) / std::sqrt(norm));
+    }
+    return state;
+}
+
+double maxDifference(const QuantumState& a, const QuantumState& b) {
+    double difference = 0.0;
+    for (int i = 0; i < a.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(a.getAmplitude(i) - b.getAmplitude(i)));
+    }
+    return difference;
+}
+
+// P|ψ⟩ from the single-qubit gates: Z = phase π, X = X, Y = i·X·Z
+QuantumState applyPauliWithGates(const QuantumState& input, const std::string& paulis, const std::vector<int>& qubits) {
+    QuantumState state = input;
+    Complex factor(1, 0);
+    for (size_t k = 0; k < paulis.size(); k++) {
+        if (paulis[k] == 'Z' || paulis[k] == 'Y') {
+            PhaseShiftGate(qubits[k], M_PI).apply(state);
+        }
+        if (paulis[k] == 'X' || paulis[k] == 'Y') {
+            XGate(qubits[k]).apply(state);
+        }
+        if (paulis[k] == 'Y') {
+            factor *= Complex(0, 1);
+        }
+    }
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, factor * state.getAmplitude(i));
+    }
+    return state;
+}
+
+void test_pauli_rotation() {
+    printTestHeader("Pauli Rotation Gate");
+
+    const double theta = 0.37;
+    struct Case { std::string paulis; std::vector<int> qubits; };
+    std::vector<Case> cases = {
+        {"X", {2}}, {"ZZ", {0, 3}}, {"XY", {1, 3}}, {"YZX", {0, 2, 4}}, {"YY", {1, 2}}
+    };
+
+    for (const Case& test_case : cases) {
+        QuantumState initial = randomState(5, 3);
+        QuantumState rotated = initial;
+        PauliRotationGate(test_case.paulis, test_case.qubits, theta).apply(rotated);
+
+        // exp(-iθP)|ψ⟩ = cos θ|ψ⟩ - i sin θ·P|ψ⟩
+        QuantumState pauli_state = applyPauliWithGates(initial, test_case.paulis, test_case.qubits);
+        QuantumState expected(5);
+        for (int i = 0; i < expected.getStateSize(); i++) {
+            expected.setAmplitude(i, std::cos(theta) * initial.getAmplitude(i)
+                                     - Complex(0, std::sin(theta)) * pauli_state.getAmplitude(i));
+        }
+        double difference = maxDifference(rotated, expected);
+        assert(difference < 1e-12 && "Pauli rotation does not match cos θ - i sin θ P");
+        assert(rotated.isNormalized() && "Pauli rotation must be unitary");
+        std::cout << "✓ exp(-iθ·" << PauliString(test_case.paulis, test_case.qubits).toString() << ") correct" << std::endl;
+    }
+}
+
+void test_trotter() {
+    printTestHeader("Trotterized Evolution");
+
+    // The ZZ couplings commute with each other, and so do the X fields
+    std::vector<PauliTerm> ising = {
+        {1.0, PauliString("ZZ", {0, 1})},
+        {1.0, PauliString("ZZ", {1, 2})},
+        {0.7, PauliString("X", {0})},
+        {0.7, PauliString("X", {1})},
+        {0.7, PauliString("X", {2})}
+    };
+    std::vector<std::vector<PauliTerm>> groups = groupCommutingTerms(ising);
+    std::cout << "Transverse-field Ising terms: " << ising.size() << " terms in " << groups.size() << " groups" << std::endl;
+    assert(groups.size() == 2 && "ZZ terms and X terms should form two commuting groups");
+
+    // A commuting Hamiltonian is exact after one step
+    std::vector<PauliTerm> commuting = {ising[0], ising[1]};
+    QuantumState one_step = randomState(3, 5);
+    QuantumState many_steps = one_step;
+    Circuit single = trotterCircuit(commuting, 0.8, 1);
+    single.apply(one_step);
+    trotterCircuit(commuting, 0.8, 7).apply(many_steps);
+    assert(single.size() == 1 && "Diagonal terms should fuse into one gate");
+    assert(maxDifference(one_step, many_steps) < 1e-12 && "Commuting terms need no Trotter steps");
+    std::cout << "✓ Commuting terms are exact in one fused step" << std::endl;
+
+    // First-order error shrinks about linearly with the step count
+    QuantumState initial = randomState(3, 9);
+    QuantumState reference = initial;
+    trotterCircuit(ising, 1.0, 400).apply(reference);
+    double previous_error = 1.0;
+    for (int steps : {10, 20, 40}) {
+        QuantumState state = initial;
+        trotterCircuit(ising, 1.0, steps).apply(state);
+        double error = maxDifference(state, reference);
+        std::cout << "  " << steps << " steps: error " << error << std::endl;
+        assert(error < previous_error * 0.7 && "Trotter error should decrease with more steps");
+        assert(state.isNormalized() && "Trotter evolution must be unitary");
+        previous_error = error;
+    }
+    std::cout << "✓ Trotter error decreases with the step count" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Hamiltonian Simulation Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_pauli_rotation();
+        test_trotter();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All Hamiltonian tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,161 @@
+#include "hybrid_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Apply the same gate to the dense reference and the hybrid state
+void applyBoth(QuantumGate&& gate, QuantumState& dense, HybridState& hybrid) {
+    gate.apply(dense);
+    hybrid.apply(gate);
+}
+
+double maxDifference(const QuantumState& dense, const HybridState& hybrid) {
+    QuantumState expanded = hybrid.toDense();
+    double difference = 0.0;
+    for (int i = 0; i < dense.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - expanded.getAmplitude(i)));
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - hybrid.getAmplitude(i)));
+    }
+    return difference;
+}
+
+void test_form_switching() {
+    printTestHeader("Switching Forms by Fill Ratio");
+
+    // 12 qubits: 4096 amplitudes, so hash → sorted at 64 nonzeros and
+    // sparse → dense at 1024
+    const int n = 12;
+    QuantumState dense(n);
+    HybridState hybrid(n);
+    assert(hybrid.getForm() == HYBRID_HASH);
+    for (int q = 0; q < 6; q++) {
+        applyBoth(HadamardGate(q), dense, hybrid);
+    }
+    assert(hybrid.getForm() == HYBRID_SORTED && hybrid.getNonzeroCount() == 64);
+    assert(maxDifference(dense, hybrid) < 1e-12);
+    std::cout << "✓ 64 nonzeros moved the state to a sorted vector" << std::endl;
+
+    applyBoth(PhaseShiftGate(2, 0.7), dense, hybrid);
+    applyBoth(CNOTGate(1, 9), dense, hybrid);
+    for (int q = 6; q < 10; q++) {
+        applyBoth(HadamardGate(q), dense, hybrid);
+    }
+    assert(hybrid.getForm() == HYBRID_DENSE);
+    assert(maxDifference(dense, hybrid) < 1e-12);
+    std::cout << "✓ Fill ratio 1/4 moved the state to dense ("
+              << hybrid.getMemoryUsage() << " bytes)" << std::endl;
+
+    // Undo the Hadamards: the dense check after DENSE_CHECK_INTERVAL
+    // gates finds a nearly empty state and returns to sparse storage
+    for (int q = 9; q >= 6; q--) {
+        applyBoth(HadamardGate(q), dense, hybrid);
+    }
+    applyBoth(CNOTGate(1, 9), dense, hybrid);
+    applyBoth(PhaseShiftGate(2, -0.7), dense, hybrid);
+    for (int q = 0; q < 2; q++) {
+        applyBoth(HadamardGate(q), dense, hybrid);
+    }
+    assert(hybrid.getForm() != HYBRID_DENSE && hybrid.getNonzeroCount() == 16);
+    assert(maxDifference(dense, hybrid) < 1e-12);
+    std::cout << "✓ Back to sparse after " << hybrid.getConversionCount() << " conversions ("
+              << hybridFormName(hybrid.getForm()) << ", " << hybrid.getNonzeroCount() << " nonzeros)" << std::endl;
+}
+
+void test_hysteresis() {
+    printTestHeader("Hysteresis");
+
+    // Growing to 128 nonzeros switches to sorted; shrinking to 32 (fill
+    // 1/128) stays there, since the way back needs fill < 1/256
+    const int n = 13;
+    HybridState hybrid(n);
+    for (int q = 0; q < 7; q++) {
+        HadamardGate h(q);
+        hybrid.apply(h);
+    }
+    assert(hybrid.getForm() == HYBRID_SORTED);
+    int conversions = hybrid.getConversionCount();
+    for (int round = 0; round < 3; round++) {
+        HadamardGate h5(5), h6(6);
+        hybrid.apply(h6);
+        hybrid.apply(h5);
+        hybrid.apply(h5);
+        hybrid.apply(h6);
+    }
+    assert(hybrid.getForm() == HYBRID_SORTED && hybrid.getConversionCount() == conversions);
+    std::cout << "✓ No conversions while the fill ratio oscillates between thresholds" << std::endl;
+}
+
+// A primitive gate with no sparse kernel: negates every amplitude
+class NegateGate : public QuantumGate {
+public:
+    void apply(QuantumState& state) override {
+        for (int i = 0; i < state.getStateSize(); i++) {
+            state.setAmplitude(i, -state.getAmplitude(i));
+        }
+    }
+};
+
+void test_modular_exponentiation() {
+    printTestHeader("Modular Exponentiation and Opaque Gates");
+
+    // 7^x mod 15 as in main: 16 of 256 amplitudes stay nonzero
+    const int n = 4;
+    const int m = 4;
+    QuantumState dense(n + m);
+    HybridState hybrid(n + m);
+    applyBoth(XGate(n), dense, hybrid);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, hybrid);
+    }
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        applyBoth(ControlledModMultGate(q, n, m, multiplier, 15), dense, hybrid);
+        multiplier = (multiplier * multiplier) % 15;
+    }
+    assert(hybrid.getForm() == HYBRID_SORTED && hybrid.getNonzeroCount() == 16);
+    applyBoth(QFTGate(0, n), dense, hybrid);  // Expanded through decompose()
+    assert(maxDifference(dense, hybrid) < 1e-12);
+    std::cout << "✓ Matches dense through the modular exponentiation and QFT" << std::endl;
+
+    applyBoth(NegateGate(), dense, hybrid);
+    assert(hybrid.getForm() == HYBRID_DENSE && "Gate without a sparse kernel needs dense storage");
+    assert(maxDifference(dense, hybrid) < 1e-12);
+    std::cout << "✓ Opaque gate converted the state to dense" << std::endl;
+
+    bool threw = false;
+    try {
+        HybridState too_large(HybridState::MAX_QUBITS + 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "States beyond MAX_QUBITS must be rejected");
+    std::cout << "✓ Oversized state rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Hybrid State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_form_switching();
+        test_hysteresis();
+        test_modular_exponentiation();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All hybrid state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,169 @@
+#include "mixed_precision_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Apply the same gate to the double reference and the mixed state
+void applyBoth(QuantumGate&& gate, QuantumState& dense, MixedPrecisionState& mixed) {
+    gate.apply(dense);
+    mixed.apply(gate);
+}
+
+double maxDifference(const QuantumState& dense, const MixedPrecisionState& mixed) {
+    QuantumState expanded = mixed.toDense();
+    double difference = 0.0;
+    for (int i = 0; i < dense.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - expanded.getAmplitude(i)));
+    }
+    return difference;
+}
+
+// Modular exponentiation with a QFT on the exponent, as in period finding
+void runCircuit(QuantumState& dense, MixedPrecisionState& mixed) {
+    const int n = 4;
+    const int m = 4;
+    applyBoth(XGate(n), dense, mixed);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, mixed);
+    }
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        applyBoth(ControlledModMultGate(q, n, m, multiplier, 15), dense, mixed);
+        multiplier = (multiplier * multiplier) % 15;
+    }
+    applyBoth(LookupModMultGate(0, 2, n, m, {1, 2, 4, 8}, 15), dense, mixed);
+    applyBoth(ControlledRegisterSwapGate(7, 0, 2, 2), dense, mixed);
+    applyBoth(ToffoliGate(0, 1, 6), dense, mixed);
+    applyBoth(SWAPGate(2, 5), dense, mixed);
+    applyBoth(QFTGate(0, n), dense, mixed);  // Expanded through decompose()
+}
+
+void test_single_precision() {
+    printTestHeader("Single-Precision Simulation");
+
+    QuantumState dense(8);
+    MixedPrecisionState mixed(8);
+    runCircuit(dense, mixed);
+    double difference = maxDifference(dense, mixed);
+    std::cout << "Max difference to double: " << difference << ", error estimate "
+              << mixed.getErrorEstimate() << std::endl;
+    assert(!mixed.isEscalated() && "Short circuit must stay in float");
+    assert(difference < 1e-6 && "Float simulation must stay close to double");
+    assert(std::abs(mixed.getNorm() - 1.0) < 1e-5);
+    assert(mixed.getMemoryUsage() * 2 == dense.getMemoryUsage());
+    std::cout << "✓ Float state matches double within " << difference << " at half the memory" << std::endl;
+}
+
+void test_escalation() {
+    printTestHeader("Escalation to Double");
+
+    // A tolerance below float rounding forces escalation at the first check
+    QuantumState dense(8);
+    MixedPrecisionState mixed(8, 1e-9, 4);
+    runCircuit(dense, mixed);
+    assert(mixed.isEscalated() && mixed.getEscalationGate() == 4);
+    assert(mixed.getMemoryUsage() == dense.getMemoryUsage());
+    assert(maxDifference(dense, mixed) < 1e-6);
+    std::cout << "✓ Escalated after " << mixed.getEscalationGate() << " gates, later gates run in double"
+              << std::endl;
+
+    // Without room for the double state, the state stays in float and warns
+    QuantumState reference(8);
+    MixedPrecisionState limited(8, 1e-9, 4, 2048);
+    runCircuit(reference, limited);
+    assert(!limited.isEscalated() && limited.hasDriftWarning());
+    assert(std::abs(limited.getNorm() - 1.0) < 1e-6 && "Drift must be renormalized away");
+    assert(maxDifference(reference, limited) < 1e-6);
+    std::cout << "✓ Memory limit keeps float and raises a drift warning" << std::endl;
+
+    // The limit covers the float and double copies during the conversion
+    QuantumState unused(8);
+    MixedPrecisionState double_only(8, 1e-9, 4, 256 * sizeof(Complex));
+    runCircuit(unused, double_only);
+    assert(!double_only.isEscalated() && "Room for the double state alone is not enough");
+    QuantumState peak_reference(8);
+    MixedPrecisionState peak(8, 1e-9, 4, 256 * (sizeof(Complex) + sizeof(ComplexFloat)));
+    runCircuit(peak_reference, peak);
+    assert(peak.isEscalated() && "Room for both copies allows escalation");
+    std::cout << "✓ Memory limit is checked against the escalation peak" << std::endl;
+}
+
+// A primitive gate without a float kernel
+class NegateGate : public QuantumGate {
+public:
+    void apply(QuantumState& state) override {
+        for (int i = 0; i < state.getStateSize(); i++) {
+            state.setAmplitude(i, -state.getAmplitude(i));
+        }
+    }
+};
+
+void test_opaque_gate() {
+    printTestHeader("Gate Without a Float Kernel");
+
+    QuantumState dense(3);
+    MixedPrecisionState mixed(3);
+    applyBoth(HadamardGate(0), dense, mixed);
+    applyBoth(NegateGate(), dense, mixed);
+    assert(mixed.isEscalated() && maxDifference(dense, mixed) < 1e-6);
+    std::cout << "✓ Opaque gate escalated the state" << std::endl;
+
+    // Multiplying by 2 mod 4 is not a permutation: no float kernel either
+    QuantumState merged(3);
+    MixedPrecisionState non_coprime(3);
+    applyBoth(XGate(0), merged, non_coprime);
+    applyBoth(XGate(1), merged, non_coprime);
+    applyBoth(ControlledModMultGate(0, 1, 2, 2, 4), merged, non_coprime);
+    assert(non_coprime.isEscalated() && maxDifference(merged, non_coprime) < 1e-6);
+    std::cout << "✓ Non-invertible multiplier escalated instead of permuting" << std::endl;
+
+    std::vector<float> values = {1, 2, 3, 4};
+    bool threw = false;
+    try {
+        permuteCycles(values.data(), values.size(), [](MixedPrecisionState::Index key) {
+            key.words[0] = key.words[0] == 0 ? 1 : key.words[0] >> 1;
+            return key;
+        });
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "A map that is not a bijection must be rejected");
+    std::cout << "✓ Cycle walk rejects a non-bijective map" << std::endl;
+
+    threw = false;
+    try {
+        MixedPrecisionState invalid(3, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Zero tolerance must be rejected");
+    std::cout << "✓ Invalid tolerance rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Mixed-Precision State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_single_precision();
+        test_escalation();
+        test_opaque_gate();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All mixed-precision state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,207 @@
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+// Layout used throughout: control | x (n) | b (n+1) | ancilla
+struct MultiplierLayout {
+    int num_bits;
+    int control() const { return 0; }
+    int xStart() const { return 1; }
+    int bStart() const { return 1 + num_bits; }
+    int ancilla() const { return 2 * num_bits + 2; }
+    int totalQubits() const { return 2 * num_bits + 3; }
+};
+
+// Control in |+⟩, x uniform over [0, N), work qubits |0⟩
+QuantumState validSuperposition(const MultiplierLayout& layout, uint64_t modulus) {
+    QuantumState state(layout.totalQubits());
+    state.setAmplitude(0, Complex(0.0, 0.0));
+    double amplitude = 1.0 / std::sqrt(2.0 * modulus);
+    for (uint64_t x = 0; x < modulus; x++) {
+        for (int c = 0; c < 2; c++) {
+            int index = (c << layout.control()) | int(x << layout.xStart());
+            state.setAmplitude(index, Complex(amplitude, 0.0));
+        }
+    }
+    return state;
+}
+
+// Check that every x maps to a·x mod N when the control is set
+void checkProducts(const QuantumState& state, const MultiplierLayout& layout,
+                   uint64_t multiplier, uint64_t modulus) {
+    double amplitude = 1.0 / std::sqrt(2.0 * modulus);
+    for (uint64_t x = 0; x < modulus; x++) {
+        for (int c = 0; c < 2; c++) {
+            uint64_t expected = c ? (multiplier * x) % modulus : x;
+            int index = (c << layout.control()) | int(expected << layout.xStart());
+            assert(std::abs(state.getAmplitude(index) - Complex(amplitude, 0.0)) < 1e-9 &&
+                   "Wrong product or work register not cleared");
+        }
+    }
+}
+
+void test_gate_level_multiplier() {
+    std::cout << "\n=== Gate-Level Beauregard Multiplier ===" << std::endl;
+
+    // 3·x mod 7 on 2·3+3 = 9 qubits
+    MultiplierLayout layout{3};
+    const uint64_t multiplier = 3;
+    const uint64_t modulus = 7;
+    BeauregardModMult gate(layout.control(), layout.xStart(), layout.bStart(), layout.ancilla(),
+                           layout.num_bits, multiplier, modulus);
+    std::cout << "Gate list length: " << gate.decompose().size() << std::endl;
+
+    QuantumState state = validSuperposition(layout, modulus);
+    gate.apply(state);
+    checkProducts(state, layout, multiplier, modulus);
+    assert(state.isNormalized() && "Multiplier must preserve normalization");
+    std::cout << "✓ |c⟩|x⟩ → |c⟩|3^c·x mod 7⟩ with work qubits returned to |0⟩" << std::endl;
+}
+
+void test_emulated_multiplier() {
+    std::cout << "\n=== Emulated Beauregard Cross-Validation ===" << std::endl;
+
+    // Gate-level and emulated runs agree on the valid subspace
+    MultiplierLayout layout{4};
+    const uint64_t multiplier = 7;
+    const uint64_t modulus = 15;
+    QuantumState reference = validSuperposition(layout, modulus);
+    QuantumState emulated = reference;
+    BeauregardModMult(layout.control(), layout.xStart(), layout.bStart(), layout.ancilla(),
+                      layout.num_bits, multiplier, modulus, GATE_LEVEL).apply(reference);
+    BeauregardModMult(layout.control(), layout.xStart(), layout.bStart(), layout.ancilla(),
+                      layout.num_bits, multiplier, modulus, EMULATED).apply(emulated);
+
+    double max_difference = 0.0;
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        max_difference = std::max(max_difference, std::abs(reference.getAmplitude(i) - emulated.getAmplitude(i)));
+    }
+    std::cout << "Max amplitude difference: " << max_difference << std::endl;
+    assert(max_difference < 1e-9 && "Emulated multiplier must match the gate-level circuit");
+    std::cout << "✓ Emulated multiplier matches gate-level circuit" << std::endl;
+
+    // Emulated mode at 21 qubits: 5·x mod 391
+    MultiplierLayout large{9};
+    const uint64_t large_multiplier = 5;
+    const uint64_t large_modulus = 391;
+    QuantumState state = validSuperposition(large, large_modulus);
+    auto start_time = std::chrono::steady_clock::now();
+    BeauregardModMult(large.control(), large.xStart(), large.bStart(), large.ancilla(),
+                      large.num_bits, large_multiplier, large_modulus, EMULATED).apply(state);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    checkProducts(state, large, large_multiplier, large_modulus);
+    std::cout << "✓ " << large.totalQubits() << "-qubit emulated run correct in " << seconds << " s" << std::endl;
+}
+
+void test_invalid_parameters() {
+    std::cout << "\n=== Invalid Parameter Test ===" << std::endl;
+
+    bool threw = false;
+    try {
+        BeauregardModMult(0, 1, 4, 8, 3, 3, 6);  // gcd(3, 6) ≠ 1
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Non-invertible multiplier must be rejected");
+
+    threw = false;
+    try {
+        BeauregardModMult(0, 1, 3, 8, 3, 3, 7);  // x and b overlap
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Overlapping registers must be rejected");
+    std::cout << "✓ Invalid multipliers and layouts rejected" << std::endl;
+}
+
+void test_lookup_multiplier() {
+    std::cout << "\n=== Windowed Lookup Multiplier Test ===" << std::endl;
+
+    // 7^x mod 15 with 5 exponent qubits in uniform superposition
+    const int exponent_qubits = 5;
+    const int target_qubits = 4;
+    const uint64_t base = 7;
+    const uint64_t modulus = 15;
+
+    std::vector<uint64_t> powers;
+    uint64_t power = base;
+    for (int i = 0; i < exponent_qubits; i++) {
+        powers.push_back(power);
+        power = (power * power) % modulus;
+    }
+
+    QuantumState reference(exponent_qubits + target_qubits);
+    reference.setAmplitude(0, Complex(0.0, 0.0));
+    reference.setAmplitude(1 << exponent_qubits, Complex(1.0, 0.0));
+    for (int i = 0; i < exponent_qubits; i++) {
+        HadamardGate(i).apply(reference);
+    }
+    QuantumState initial = reference;
+
+    // Reference: one controlled multiplication per exponent bit
+    for (int i = 0; i < exponent_qubits; i++) {
+        ControlledModMultGate(i, exponent_qubits, target_qubits, powers[i], modulus).apply(reference);
+    }
+
+    // Windows of 2 and 3 (the last window is narrower)
+    for (int window : {2, 3}) {
+        QuantumState state = initial;
+        int gate_count = 0;
+        for (int j = 0; j < exponent_qubits; j += window) {
+            int width = std::min(window, exponent_qubits - j);
+            std::vector<uint64_t> table(size_t(1) << width, 1);
+            for (size_t k = 0; k < table.size(); k++) {
+                for (int b = 0; b < width; b++) {
+                    if ((k >> b) & 1) {
+                        table[k] = (table[k] * powers[j + b]) % modulus;
+                    }
+                }
+            }
+            LookupModMultGate(j, width, exponent_qubits, target_qubits, table, modulus).apply(state);
+            gate_count++;
+        }
+
+        double max_difference = 0.0;
+        for (int i = 0; i < state.getStateSize(); i++) {
+            max_difference = std::max(max_difference, std::abs(state.getAmplitude(i) - reference.getAmplitude(i)));
+        }
+        assert(max_difference == 0.0 && "Windowed lookup must match per-bit multiplications");
+        std::cout << "✓ Window " << window << ": " << gate_count << " lookup gates match "
+                  << exponent_qubits << " controlled multiplications" << std::endl;
+    }
+
+    bool threw = false;
+    try {
+        LookupModMultGate(0, 2, 4, 4, {1, 7, 4}, 15);  // 3 entries for a 2-qubit window
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Table size must match the window");
+    std::cout << "✓ Mis-sized multiplier table rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Modular Multiplier Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_gate_level_multiplier();
+        test_emulated_multiplier();
+        test_invalid_parameters();
+        test_lookup_multiplier();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All modular multiplier tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
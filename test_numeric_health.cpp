@@ -0,0 +1,164 @@
+#include "numeric_health.h"
+#include "quantum_gates.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+double stateNorm(const QuantumState& state) {
+    double norm = 0.0;
+    for (int i = 0; i < state.getStateSize(); i++) {
+        norm += std::norm(state.getAmplitude(i));
+    }
+    return norm;
+}
+
+void test_clean_circuit() {
+    printTestHeader("Clean Circuit");
+
+    QuantumState state(10);
+    Circuit circuit;
+    for (int q = 0; q < 10; q++) {
+        circuit.add<HadamardGate>(q);
+        circuit.add<PhaseShiftGate>(q, 0.1 * (q + 1));
+    }
+    HealthMonitor monitor;
+    monitor.run(circuit, state);
+    const HealthStats& stats = monitor.getStats();
+    assert(stats.gates == 20 && stats.checks == 20);
+    assert(stats.violations.empty() && stats.renormalizations == 0);
+    assert(monitor.isHealthy() && stats.max_drift < 1e-12);
+    std::cout << "✓ 20 gates, 20 checks, no violations (max drift " << stats.max_drift << ")" << std::endl;
+
+    // A longer interval checks less often
+    QuantumState sparse_checks(10);
+    HealthMonitor every_fifth(1e-10, 5);
+    every_fifth.run(circuit, sparse_checks);
+    assert(every_fifth.getStats().checks == 4);
+    std::cout << "✓ Check interval 5 ran 4 checks" << std::endl;
+}
+
+void test_drift() {
+    printTestHeader("Norm Drift");
+
+    QuantumState state(4);
+    for (int q = 0; q < 4; q++) {
+        HadamardGate(q).apply(state);
+    }
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, state.getAmplitude(i) * 1.001);
+    }
+    HealthMonitor monitor(1e-8);
+    assert(!monitor.check(state));
+    const HealthStats& stats = monitor.getStats();
+    assert(stats.renormalizations == 1 && stats.violations.size() == 1);
+    assert(stats.violations[0].kind == "drift" && stats.violations[0].block == -1);
+    assert(std::abs(stats.max_drift - (1.001 * 1.001 - 1.0)) < 1e-12);
+    assert(std::abs(stateNorm(state) - 1.0) < 1e-14);
+    assert(std::abs(state.getAmplitude(5).real() - 0.25) < 1e-14);
+    std::cout << "✓ Drift " << stats.max_drift << " reported and renormalized away" << std::endl;
+
+    // Within tolerance: reported in max_drift only, state untouched
+    state.setAmplitude(0, state.getAmplitude(0) * (1.0 + 1e-12));
+    Complex before = state.getAmplitude(0);
+    assert(monitor.check(state));
+    assert(state.getAmplitude(0) == before && monitor.getStats().renormalizations == 1);
+    std::cout << "✓ Drift within tolerance leaves the state as it is" << std::endl;
+}
+
+void test_denormals() {
+    printTestHeader("Denormal Amplitudes");
+
+    // Two blocks of amplitudes; denormals only in the second
+    const int n = 13;
+    QuantumState state(n);
+    double tiny = std::numeric_limits<double>::denorm_min() * 1000;
+    state.setAmplitude(HealthMonitor::BLOCK_SIZE + 7, Complex(tiny, -tiny));
+    HealthMonitor monitor;
+    assert(!monitor.check(state));
+    const HealthStats& stats = monitor.getStats();
+    assert(stats.denormals == 2 && stats.renormalizations == 0);
+    assert(stats.violations.size() == 1);
+    assert(stats.violations[0].kind == "denormal" && stats.violations[0].block == 1);
+    assert(stats.violations[0].value == 2.0);
+    assert(state.getAmplitude(HealthMonitor::BLOCK_SIZE + 7) == Complex(0, 0));
+    assert(state.getAmplitude(0) == Complex(1, 0));
+    std::cout << "✓ 2 denormal components found in block 1 and flushed to zero" << std::endl;
+}
+
+void test_nonfinite() {
+    printTestHeader("Non-Finite Amplitudes");
+
+    QuantumState state(3);
+    state.setAmplitude(3, Complex(std::numeric_limits<double>::quiet_NaN(), 0));
+    HealthMonitor monitor;
+    assert(!monitor.check(state));
+    assert(!monitor.isHealthy() && monitor.getStats().nonfinite == 1);
+    assert(monitor.getStats().violations[0].kind == "nonfinite");
+    assert(monitor.getStats().renormalizations == 0 && state.getAmplitude(0) == Complex(1, 0));
+    std::cout << "✓ NaN reported, state left unrepaired" << std::endl;
+
+    monitor.resetStats();
+    assert(monitor.isHealthy() && monitor.getStats().violations.empty());
+    std::cout << "✓ Statistics reset" << std::endl;
+
+    bool threw = false;
+    try {
+        HealthMonitor invalid(1e-10, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Zero check interval must be rejected");
+    std::cout << "✓ Invalid check interval rejected" << std::endl;
+}
+
+void test_flush_scope() {
+    printTestHeader("Flush-to-Zero Scope");
+
+    if (!FlushDenormalsScope::isSupported()) {
+        std::cout << "FTZ/DAZ not available on this target, skipped" << std::endl;
+        return;
+    }
+    volatile double small = 1e-300;
+    volatile double factor = 1e-20;
+    bool was_active = FlushDenormalsScope::isActive();
+    {
+        FlushDenormalsScope scope;
+        assert(FlushDenormalsScope::isActive());
+        assert(small * factor == 0.0 && "Denormal results must flush to zero");
+    }
+    assert(FlushDenormalsScope::isActive() == was_active);
+    if (!was_active) {
+        assert(small * factor != 0.0 && "Previous mode must be restored");
+    }
+    std::cout << "✓ Denormal results flush to zero inside the scope, mode restored after" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Numerical Health Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_clean_circuit();
+        test_drift();
+        test_denormals();
+        test_nonfinite();
+        test_flush_scope();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All numerical health tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
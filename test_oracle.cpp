@@ -0,0 +1,190 @@
+#include "quantum_oracle.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Distinct amplitudes so that any misplaced entry is caught
+QuantumState distinctState(int num_qubits) {
+    QuantumState state(num_qubits);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        state.setAmplitude(i, Complex(i + 1, 0.5 * i));
+    }
+    return state;
+}
+
+void test_xor_oracle_modexp() {
+    printTestHeader("XOR Oracle: Modular Exponentiation");
+
+    // |x⟩|0⟩ → |x⟩|7^x mod 15⟩ in one oracle, against the per-bit circuit
+    const int exponent_qubits = 4;
+    const int target_qubits = 4;
+    const uint64_t base = 7;
+    const uint64_t modulus = 15;
+    auto power = [=](uint64_t x) {
+        uint64_t result = 1;
+        for (uint64_t i = 0; i < x; i++) {
+            result = (result * base) % modulus;
+        }
+        return result;
+    };
+
+    QuantumState oracle_state(exponent_qubits + target_qubits);
+    for (int i = 0; i < exponent_qubits; i++) {
+        HadamardGate(i).apply(oracle_state);
+    }
+    OracleGate<decltype(power)>(0, exponent_qubits, exponent_qubits, target_qubits, power).apply(oracle_state);
+
+    QuantumState circuit_state(exponent_qubits + target_qubits);
+    circuit_state.setAmplitude(0, Complex(0, 0));
+    circuit_state.setAmplitude(1 << exponent_qubits, Complex(1, 0));
+    for (int i = 0; i < exponent_qubits; i++) {
+        HadamardGate(i).apply(circuit_state);
+    }
+    uint64_t multiplier = base;
+    for (int i = 0; i < exponent_qubits; i++) {
+        ControlledModMultGate(i, exponent_qubits, target_qubits, multiplier, modulus).apply(circuit_state);
+        multiplier = (multiplier * multiplier) % modulus;
+    }
+
+    for (int i = 0; i < oracle_state.getStateSize(); i++) {
+        assert(std::abs(oracle_state.getAmplitude(i) - circuit_state.getAmplitude(i)) < 1e-12 &&
+               "Oracle must match the controlled multiplication circuit");
+    }
+    std::cout << "✓ One XOR oracle reproduces " << exponent_qubits << " controlled multiplications" << std::endl;
+}
+
+void test_oracle_modes() {
+    printTestHeader("XOR and ADD Oracle Modes");
+
+    // Table oracle f(x) = 3x + 1 on a 3-qubit input, 3-qubit target, spectator qubit 6
+    FunctionTable table{{1, 4, 7, 10, 13, 16, 19, 22}};
+    QuantumState initial = distinctState(7);
+
+    // XOR twice is the identity
+    QuantumState state = initial;
+    OracleGate<FunctionTable> xor_oracle(0, 3, 3, 3, table, ORACLE_XOR);
+    xor_oracle.apply(state);
+    xor_oracle.apply(state);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        assert(state.getAmplitude(i) == initial.getAmplitude(i) && "XOR oracle must be self-inverse");
+    }
+    std::cout << "✓ XOR oracle is self-inverse" << std::endl;
+
+    // ADD moves the amplitude at |x, y⟩ to |x, y + f(x) mod 8⟩
+    state = initial;
+    OracleGate<FunctionTable> add_oracle(0, 3, 3, 3, table, ORACLE_ADD);
+    add_oracle.apply(state);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        int x = i & 7;
+        int y = (i >> 3) & 7;
+        int j = (i & ~(7 << 3)) | (int((y + table(x)) & 7) << 3);
+        assert(state.getAmplitude(j) == initial.getAmplitude(i) && "ADD oracle moved an amplitude wrongly");
+    }
+    std::cout << "✓ ADD oracle computes y + f(x) mod 8" << std::endl;
+    std::cout << "  " << add_oracle.describe() << std::endl;
+
+    bool threw = false;
+    try {
+        OracleGate<FunctionTable>(0, 3, 3, 3, FunctionTable{{1, 2, 3}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Mis-sized function table must be rejected");
+    std::cout << "✓ Mis-sized function table rejected" << std::endl;
+}
+
+void test_permutation_oracle() {
+    printTestHeader("In-Place Permutation Oracle");
+
+    // g(x) = 5x + 3 mod 16 on qubits 1-4 of a 6-qubit state
+    auto affine = [](uint64_t x) { return (5 * x + 3) % 16; };
+    PermutationOracleGate<decltype(affine)> gate(1, 4, affine);
+    QuantumState initial = distinctState(6);
+    QuantumState state = initial;
+    gate.apply(state);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        int x = (i >> 1) & 15;
+        int j = (i & ~(15 << 1)) | (int(affine(x)) << 1);
+        assert(state.getAmplitude(j) == initial.getAmplitude(i) && "Permutation moved an amplitude wrongly");
+    }
+    std::cout << "✓ |x⟩ → |5x + 3 mod 16⟩ applied in place (" << gate.getCycleCount() << " cycles)" << std::endl;
+
+    bool threw = false;
+    try {
+        PermutationOracleGate<FunctionTable>(0, 2, FunctionTable{{0, 1, 1, 3}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Non-bijective function must be rejected");
+    std::cout << "✓ Non-bijective function rejected" << std::endl;
+}
+
+void test_phase_oracle() {
+    printTestHeader("Phase Oracle");
+
+    // Mark x = 5 on qubits 0-2 and compare with the ancilla-free gate chain:
+    // X on the zero bits of 5, doubly controlled Z, X again
+    QuantumState initial = distinctState(4);
+    QuantumState oracle_state = initial;
+    auto marked = [](uint64_t x) { return x == 5; };
+    PhaseOracleGate<decltype(marked)>(0, 3, marked).apply(oracle_state);
+
+    QuantumState chain_state = initial;
+    XGate(1).apply(chain_state);
+    ControlledPhaseShiftGate(std::vector<int>{0, 1}, 2, M_PI).apply(chain_state);
+    XGate(1).apply(chain_state);
+    for (int i = 0; i < oracle_state.getStateSize(); i++) {
+        assert(std::abs(oracle_state.getAmplitude(i) - chain_state.getAmplitude(i)) < 1e-12 &&
+               "Predicate oracle must match the gate chain");
+    }
+    std::cout << "✓ Predicate oracle matches X/controlled-Z/X chain" << std::endl;
+
+    // Phase function f(x) = x/2 on qubits 1-2: |x⟩ → i^x |x⟩
+    QuantumState state = initial;
+    auto quarter_turns = [](uint64_t x) { return double(x) / 2.0; };
+    PhaseOracleGate<decltype(quarter_turns)>(1, 2, quarter_turns).apply(state);
+    const Complex powers_of_i[] = {Complex(1, 0), Complex(0, 1), Complex(-1, 0), Complex(0, -1)};
+    for (int i = 0; i < state.getStateSize(); i++) {
+        Complex expected = initial.getAmplitude(i) * powers_of_i[(i >> 1) & 3];
+        assert(std::abs(state.getAmplitude(i) - expected) < 1e-12 && "Phase function oracle incorrect");
+    }
+    std::cout << "✓ Phase function oracle applies e^(iπ·f(x))" << std::endl;
+
+    // Table-driven: odd entries flip the sign
+    state = initial;
+    PhaseOracleGate<FunctionTable> table_oracle(0, 2, FunctionTable{{0, 1, 0, 1}});
+    table_oracle.apply(state);
+    for (int i = 0; i < state.getStateSize(); i++) {
+        double sign = (i & 1) ? -1.0 : 1.0;
+        assert(std::abs(state.getAmplitude(i) - sign * initial.getAmplitude(i)) < 1e-12 && "Table oracle incorrect");
+    }
+    std::cout << "✓ Table oracle " << table_oracle.describe() << " correct" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Oracle Gate Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_xor_oracle_modexp();
+        test_oracle_modes();
+        test_permutation_oracle();
+        test_phase_oracle();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All oracle tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
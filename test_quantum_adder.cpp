@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <random>
 
 void test_quantum_adder() {
     std::cout << "\n=== Quantum Adder Test ===" << std::endl;
@@ -122,6 +123,129 @@ void test_quantum_adder() {
     std::cout << "✓ Quantum adder with carry test passed!" << std::endl;
 }
 
+// Cross-validate the emulated adder against the gate-level reference
+// on a random superposition (including nonzero carry inputs)
+void test_emulated_adder() {
+    std::cout << "\n=== Emulated Adder Cross-Validation ===" << std::endl;
+
+    const int num_bits = 3;
+    const int total_qubits = 3 * num_bits + 2;  // a, b, carries, one spectator qubit
+    std::mt19937 rng(42);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+
+    QuantumState reference(total_qubits);
+    double norm = 0.0;
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        Complex amp(gaussian(rng), gaussian(rng));
+        reference.setAmplitude(i, amp);
+        norm += std::norm(amp);
+    }
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        reference.setAmplitude(i, reference.getAmplitude(i) / std::sqrt(norm));
+    }
+    QuantumState emulated = reference;
+
+    QuantumAdder gate_level(0, num_bits, 2 * num_bits, num_bits, GATE_LEVEL);
+    QuantumAdder fast(0, num_bits, 2 * num_bits, num_bits, EMULATED);
+    gate_level.apply(reference);
+    fast.apply(emulated);
+
+    double max_difference = 0.0;
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        max_difference = std::max(max_difference, std::abs(reference.getAmplitude(i) - emulated.getAmplitude(i)));
+    }
+    std::cout << "Max amplitude difference: " << max_difference << std::endl;
+    assert(max_difference == 0.0 && "Emulated adder must match the gate-level adder exactly");
+    assert(emulated.isNormalized() && "Emulated adder must preserve normalization");
+    std::cout << "✓ Emulated adder matches gate-level adder" << std::endl;
+}
+
+void test_draper_adder() {
+    std::cout << "\n=== Draper QFT Adder Test ===" << std::endl;
+
+    // Layout: |a⟩|b⟩ only, no carry qubits
+    const int num_bits = 3;
+    const int total_qubits = 2 * num_bits;
+    const int modulus = 1 << num_bits;
+
+    // Every basis input, both execution modes
+    for (int a = 0; a < modulus; a++) {
+        for (int b = 0; b < modulus; b++) {
+            int input = a | (b << num_bits);
+            int expected = a | (((a + b) % modulus) << num_bits);
+            for (ArithmeticMode mode : {GATE_LEVEL, EMULATED}) {
+                QuantumState state(total_qubits);
+                state.setAmplitude(0, Complex(0.0, 0.0));
+                state.setAmplitude(input, Complex(1.0, 0.0));
+                DraperAdder adder(0, num_bits, num_bits, mode);
+                adder.apply(state);
+                assert(std::abs(state.getAmplitude(expected)) > 1.0 - 1e-9 && "Draper adder computed the wrong sum");
+            }
+        }
+    }
+    std::cout << "✓ All " << modulus * modulus << " sums correct in both modes" << std::endl;
+
+    // The fused φADD sweep matches its controlled-rotation decomposition
+    std::mt19937 rng(7);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    QuantumState fused(total_qubits + 1);
+    for (int i = 0; i < fused.getStateSize(); i++) {
+        fused.setAmplitude(i, Complex(gaussian(rng), gaussian(rng)));
+    }
+    QuantumState rotations = fused;
+    FourierAdderGate phase_add(0, num_bits, num_bits);
+    phase_add.apply(fused);
+    for (const auto& gate : phase_add.decompose()) {
+        gate->apply(rotations);
+    }
+    double max_difference = 0.0;
+    for (int i = 0; i < fused.getStateSize(); i++) {
+        max_difference = std::max(max_difference, std::abs(fused.getAmplitude(i) - rotations.getAmplitude(i)));
+    }
+    std::cout << "Fused vs rotation-by-rotation difference: " << max_difference << std::endl;
+    assert(max_difference < 1e-9 && "Fused phase layer must match its decomposition");
+    std::cout << "✓ Fused phase layer matches its decomposition" << std::endl;
+
+    // Registers wider than 31 bits (sparse states) still get exact angles
+    const int wide_bits = 40;
+    double smallest = 1.0;
+    for (const auto& gate : QFTGate(0, wide_bits).decompose()) {
+        auto rotation = std::dynamic_pointer_cast<ControlledPhaseShiftGate>(gate);
+        if (rotation) {
+            smallest = std::min(smallest, rotation->getPhase());
+        }
+    }
+    assert(smallest == std::ldexp(M_PI, -(wide_bits - 1)) && "Smallest QFT rotation is π/2^(n-1)");
+    auto widest = FourierAdderGate(0, wide_bits, wide_bits).decompose().front();
+    double first_angle = std::dynamic_pointer_cast<ControlledPhaseShiftGate>(widest)->getPhase();
+    assert(first_angle == std::ldexp(2.0 * M_PI, -wide_bits) && "First φADD rotation is 2π/2^n");
+    std::cout << "✓ " << wide_bits << "-bit QFT and φADD rotation angles are exact" << std::endl;
+}
+
+void test_constant_adder() {
+    std::cout << "\n=== Constant Adder Test ===" << std::endl;
+
+    // Register b on qubits 1-4, with a spectator qubit 0 in superposition
+    const int num_bits = 4;
+    const int modulus = 1 << num_bits;
+    for (int64_t constant : {int64_t(5), int64_t(-3), int64_t(21)}) {
+        for (int b = 0; b < modulus; b++) {
+            int64_t sum = ((b + constant) % modulus + modulus) % modulus;
+            for (ArithmeticMode mode : {GATE_LEVEL, EMULATED}) {
+                QuantumState state(num_bits + 1);
+                state.setAmplitude(0, Complex(0.0, 0.0));
+                state.setAmplitude(b << 1, Complex(1.0 / std::sqrt(2.0), 0.0));
+                state.setAmplitude((b << 1) | 1, Complex(1.0 / std::sqrt(2.0), 0.0));
+                ConstantAdder adder(1, num_bits, constant, mode);
+                adder.apply(state);
+                assert(std::abs(state.getAmplitude(int(sum << 1)) - Complex(1.0 / std::sqrt(2.0), 0.0)) < 1e-9);
+                assert(std::abs(state.getAmplitude(int(sum << 1) | 1) - Complex(1.0 / std::sqrt(2.0), 0.0)) < 1e-9);
+            }
+        }
+        std::cout << "✓ b + (" << constant << ") mod " << modulus << " correct for all b" << std::endl;
+    }
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "   Quantum Adder Test Suite" << std::endl;
@@ -129,6 +253,9 @@ int main() {
     
     try {
         test_quantum_adder();
+        test_emulated_adder();
+        test_draper_adder();
+        test_constant_adder();
         
         std::cout << "\n========================================" << std::endl;
         std::cout << "   All quantum adder tests passed! ✓" << std::endl;
@@ -2,6 +2,8 @@
 #include "quantum_state.h"
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <random>
 
 // Helper function to initialize a quantum state with a specific value in a register
 void initializeRegister(QuantumState& state, int start, int count, int value) {
@@ -191,12 +193,36 @@ void testEdgeCases() {
     std::cout << "Edge case tests passed!" << std::endl;
 }
 
+// Cross-validate the emulated comparator against the gate-level reference
+void testEmulatedComparator() {
+    std::cout << "\nTesting emulated comparator against gate-level comparator..." << std::endl;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+    // a: 0-2, b: 3-5, result: 6-9 (num_bits + 1 qubits)
+    QuantumState reference(10);
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        reference.setAmplitude(i, Complex(uniform(rng), uniform(rng)));
+    }
+    QuantumState emulated = reference;
+
+    QuantumComparator(0, 3, 6, 3, -1, GATE_LEVEL).apply(reference);
+    QuantumComparator(0, 3, 6, 3, -1, EMULATED).apply(emulated);
+
+    for (int i = 0; i < reference.getStateSize(); i++) {
+        assert(reference.getAmplitude(i) == emulated.getAmplitude(i));
+    }
+    std::cout << "Emulated comparator matches gate-level comparator!" << std::endl;
+}
+
 int main() {
     std::cout << "=== Quantum Comparator Tests ===" << std::endl;
     
     try {
         testBasicComparison();
         testEdgeCases();
+        testEmulatedComparator();
         
         std::cout << "\nAll tests completed!" << std::endl;
         std::cout << "\nNote: The current implementation is a simplified demonstration of equality comparison." << std::endl;
@@ -0,0 +1,201 @@
+#include "sparse_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Apply the same gate to the dense reference and both sparse forms
+void applyAll(QuantumGate&& gate, QuantumState& dense, SparseState<1>& sparse, SortedSparseState<1>& sorted) {
+    gate.apply(dense);
+    sparse.apply(gate);
+    sorted.apply(gate);
+}
+
+void test_wide_index() {
+    printTestHeader("Wide Index Fields");
+
+    // A 20-bit field straddling the boundary between words 0 and 1
+    WideIndex<2> index;
+    index.setField(54, 20, 0xABCDE);
+    assert(index.field(54, 20) == 0xABCDE);
+    assert(index.words[0] == (uint64_t(0xABCDE & 0x3FF) << 54) && index.words[1] == (0xABCDE >> 10));
+    assert(index.bit(54 + 1) && !index.bit(54));
+    std::cout << "✓ Field across the 64-bit word boundary" << std::endl;
+
+    // Full 64-bit field at an unaligned position
+    uint64_t value = 0xFEDCBA9876543210ULL;
+    index.setField(10, 64, value);
+    assert(index.field(10, 64) == value);
+    assert(index.field(54, 20) == (value >> 44));
+    index.flip(127);
+    assert(index.bit(127) && index.field(74, 54) == (uint64_t(1) << 53));
+
+    WideIndex<2> copy = index;
+    WideIndexHash<2> hash;
+    assert(copy == index && hash(copy) == hash(index));
+    copy.flip(100);
+    assert(!(copy == index) && index < copy);
+    std::cout << "✓ 64-bit fields, equality, hashing and ordering" << std::endl;
+}
+
+void test_sparse_vs_dense() {
+    printTestHeader("Sparse Gates vs Dense Simulation");
+
+    const int n = 8;
+    QuantumState dense(n);
+    SparseState<1> sparse(n);
+    SortedSparseState<1> sorted(n);
+    applyAll(XGate(4), dense, sparse, sorted);
+    for (int q = 0; q < 3; q++) {
+        applyAll(HadamardGate(q), dense, sparse, sorted);
+    }
+    applyAll(PhaseShiftGate(1, 0.3), dense, sparse, sorted);
+    applyAll(ControlledPhaseShiftGate(std::vector<int>{0, 2}, 1, 0.9), dense, sparse, sorted);
+    applyAll(ControlledModMultGate(0, 4, 4, 7, 15), dense, sparse, sorted);
+    applyAll(LookupModMultGate(1, 2, 4, 4, {1, 2, 4, 8}, 15), dense, sparse, sorted);
+    applyAll(CNOTGate(2, 3), dense, sparse, sorted);
+    applyAll(ToffoliGate(0, 3, 7), dense, sparse, sorted);
+    applyAll(SWAPGate(1, 6), dense, sparse, sorted);
+    applyAll(RegisterSwapGate(0, 4, 2), dense, sparse, sorted);
+    applyAll(ControlledRegisterSwapGate(7, 0, 5, 2), dense, sparse, sorted);
+    size_t before_qft = sparse.getNonzeroCount();
+    applyAll(QFTGate(0, 3), dense, sparse, sorted);  // Expanded through decompose()
+
+    double difference = 0.0;
+    size_t nonzero = 0;
+    for (int i = 0; i < dense.getStateSize(); i++) {
+        WideIndex<1> key;
+        key.setField(0, n, uint64_t(i));
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - sparse.getAmplitude(key)));
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - sorted.getAmplitude(key)));
+        if (std::abs(dense.getAmplitude(i)) >= SparseState<1>::ZERO_TOLERANCE) {
+            nonzero++;
+        }
+    }
+    std::cout << "Max difference to dense: " << difference << std::endl;
+    assert(difference < 1e-12 && "Sparse state must match the dense state");
+    assert(sparse.getNonzeroCount() == nonzero && "Cancelled amplitudes must be dropped");
+    assert(sorted.getNonzeroCount() == nonzero);
+    assert(std::is_sorted(sorted.getEntries().begin(), sorted.getEntries().end(),
+                          [](const SortedSparseState<1>::Entry& lhs, const SortedSparseState<1>::Entry& rhs) {
+                              return lhs.first < rhs.first;
+                          }));
+    std::cout << "✓ Hash and sorted forms match dense simulation (" << before_qft << " → " << sparse.getNonzeroCount()
+              << " nonzeros through the QFT)" << std::endl;
+
+    // H twice restores the original support
+    SparseState<1> flip(3);
+    HadamardGate h(2);
+    flip.apply(h);
+    flip.apply(h);
+    assert(flip.getNonzeroCount() == 1 && "Interference must remove zero amplitudes");
+    std::cout << "✓ Interference removes cancelled entries" << std::endl;
+}
+
+void test_wide_modular_exponentiation() {
+    printTestHeader("Modular Exponentiation with a 64-bit Modulus");
+
+    // 3^x mod (2^64 - 59) with a 6-qubit exponent: the 64-qubit target
+    // register occupies qubits 6-69, across the word boundary
+    const int n = 6;
+    const int m = 64;
+    const uint64_t base = 3;
+    const uint64_t modulus = 18446744073709551557ULL;
+    SparseState128 sparse(n + m);
+    XGate one(n);
+    sparse.apply(one);
+    for (int q = 0; q < n; q++) {
+        HadamardGate h(q);
+        sparse.apply(h);
+    }
+    uint64_t multiplier = base;
+    for (int q = 0; q < n; q++) {
+        ControlledModMultGate gate(q, n, m, multiplier, modulus);
+        sparse.apply(gate);
+        multiplier = mulMod(multiplier, multiplier, modulus);
+    }
+
+    assert(sparse.getNonzeroCount() == (1u << n));
+    assert(std::abs(sparse.getNorm() - 1.0) < 1e-12);
+    for (const auto& entry : sparse.getAmplitudes()) {
+        uint64_t x = entry.first.field(0, n);
+        uint64_t expected = 1;
+        for (uint64_t k = 0; k < x; k++) {
+            expected = mulMod(expected, base, modulus);
+        }
+        assert(entry.first.field(n, m) == expected && "Target must hold 3^x mod N");
+        assert(std::abs(std::norm(entry.second) - 1.0 / (1 << n)) < 1e-12);
+    }
+    std::cout << "✓ " << n + m << "-qubit state holds 3^x mod (2^64 - 59) in "
+              << sparse.getMemoryUsage() << " bytes" << std::endl;
+
+    // Three words: qubits beyond 128
+    SparseState<3> wide(192);
+    HadamardGate h(130);
+    CNOTGate entangle(130, 191);
+    wide.apply(h);
+    wide.apply(entangle);
+    WideIndex<3> both;
+    both.flip(130);
+    both.flip(191);
+    assert(wide.getNonzeroCount() == 2 && std::abs(wide.getProbability(both) - 0.5) < 1e-12);
+    std::cout << "✓ Bell pair on qubits 130 and 191 of a 192-qubit state" << std::endl;
+}
+
+// A primitive gate with no sparse kernel
+class OpaqueGate : public QuantumGate {
+public:
+    void apply(QuantumState&) override {}
+};
+
+void test_invalid_gates() {
+    printTestHeader("Invalid Gates");
+
+    SparseState128 sparse(70);
+    bool threw = false;
+    try {
+        XGate gate(70);
+        sparse.apply(gate);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Gate beyond the state must be rejected");
+
+    threw = false;
+    try {
+        OpaqueGate gate;
+        sparse.apply(gate);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Gate without a sparse kernel must be rejected");
+    std::cout << "✓ Out-of-range and unsupported gates rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Sparse State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_wide_index();
+        test_sparse_vs_dense();
+        test_wide_modular_exponentiation();
+        test_invalid_gates();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All sparse state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
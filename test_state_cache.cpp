@@ -0,0 +1,285 @@
+#include "circuit.h"
+#include "state_cache.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Helper: true if two states have identical amplitudes (within tolerance)
+bool sameState(const QuantumState& a, const QuantumState& b) {
+    if (a.getNumQubits() != b.getNumQubits()) {
+        return false;
+    }
+    for (int i = 0; i < a.getStateSize(); i++) {
+        if (std::abs(a.getAmplitude(i) - b.getAmplitude(i)) > 1e-12) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Build the modular exponentiation circuit used by main.cpp (7^x mod 15)
+Circuit buildModExp(int exponent_qubits) {
+    Circuit circuit;
+    for (int i = 0; i < exponent_qubits; i++) {
+        circuit.add<HadamardGate>(i);
+    }
+    uint64_t power = 7;
+    for (int i = 0; i < exponent_qubits; i++) {
+        circuit.add<ControlledModMultGate>(i, exponent_qubits, 4, power, 15);
+        power = (power * power) % 15;
+    }
+    return circuit;
+}
+
+// Same circuit with the target register on qubits 0-3, control qubit i on
+// qubit 4 + i, and each Hadamard right before the multiplication it controls
+// (the layout main.cpp uses for cached runs)
+Circuit buildInterleavedModExp(int exponent_qubits) {
+    Circuit circuit;
+    uint64_t power = 7;
+    for (int i = 0; i < exponent_qubits; i++) {
+        circuit.add<HadamardGate>(4 + i);
+        circuit.add<ControlledModMultGate>(4 + i, 0, 4, power, 15);
+        power = (power * power) % 15;
+    }
+    return circuit;
+}
+
+// Test 1: A cached run resumes from the longest prefix and gives the same state
+void test_resume_from_prefix() {
+    printTestHeader("Prefix Resume Test");
+
+    StatePrefixCache cache(1 << 20);
+    Circuit full = buildModExp(4);
+
+    // Reference result without cache
+    QuantumState reference(8);
+    reference.setAmplitude(0, Complex(0, 0));
+    reference.setAmplitude(1 << 4, Complex(1, 0));
+    QuantumState initial = reference;
+    full.apply(reference);
+
+    // First cached run computes everything, with a snapshot every 2 gates
+    QuantumState first = initial;
+    full.apply(first, cache, 2);
+    assert(full.getGatesSkipped() == 0 && "First run should not skip any gate");
+    assert(sameState(first, reference) && "Cached run must match uncached run");
+    std::cout << "✓ First run matches reference (" << cache.getEntryCount() << " snapshots stored)" << std::endl;
+
+    // A circuit sharing the first 6 gates resumes after them
+    Circuit variant;
+    for (size_t k = 0; k < 6; k++) {
+        variant.add(full[k]);
+    }
+    variant.add<ControlledModMultGate>(2, 4, 4, 2, 15);  // Different last gate
+    QuantumState expected = initial;
+    variant.apply(expected);
+
+    QuantumState resumed = initial;
+    variant.apply(resumed, cache);
+    std::cout << "Variant skipped " << variant.getGatesSkipped() << " gates (expected 6)" << std::endl;
+    assert(variant.getGatesSkipped() == 6 && "Variant should resume after the shared prefix");
+    assert(sameState(resumed, expected) && "Resumed run must match full run");
+    std::cout << "✓ Resume from longest prefix test passed" << std::endl;
+
+    // A different initial state must not hit the cache
+    QuantumState other(8);
+    full.apply(other, cache);
+    assert(full.getGatesSkipped() == 0 && "Different initial state must miss");
+    std::cout << "✓ Initial state is part of the fingerprint" << std::endl;
+}
+
+// Test 2: LRU eviction keeps memory under the budget
+void test_lru_budget() {
+    printTestHeader("LRU Budget Test");
+
+    QuantumState state(6);  // 1 KB per snapshot
+    size_t snapshot_bytes = state.getMemoryUsage();
+    StatePrefixCache cache(3 * snapshot_bytes);
+
+    for (uint64_t key = 1; key <= 5; key++) {
+        cache.insert(key, state);
+    }
+    std::cout << "Entries: " << cache.getEntryCount() << ", evictions: " << cache.getEvictions() << std::endl;
+    assert(cache.getEntryCount() == 3 && "Only three snapshots fit in the budget");
+    assert(cache.getMemoryUsed() <= cache.getMemoryBudget() && "Budget must be respected");
+    assert(!cache.contains(1) && !cache.contains(2) && "Oldest entries are evicted first");
+    assert(cache.contains(5) && "Newest entry is kept");
+
+    // Touching key 3 makes key 4 the least recently used
+    QuantumState restored(6);
+    assert(cache.lookup(3, restored) && "Key 3 should be cached");
+    cache.insert(6, state);
+    assert(cache.contains(3) && !cache.contains(4) && "LRU order should follow lookups");
+    std::cout << "✓ LRU eviction test passed" << std::endl;
+}
+
+// Test 3: Prefixes carry over between exponent widths
+void test_cross_width() {
+    printTestHeader("Cross-Width Prefix Test");
+
+    StatePrefixCache cache(1 << 20);
+    Circuit narrow = buildInterleavedModExp(3);
+    QuantumState first(7);
+    first.setAmplitude(0, Complex(0, 0));
+    first.setAmplitude(1, Complex(1, 0));
+    narrow.apply(first, cache, 2);
+    assert(narrow.getGatesSkipped() == 0);
+
+    // One more exponent qubit: the narrow snapshots are padded with |0⟩
+    Circuit wide = buildInterleavedModExp(4);
+    QuantumState reference(8);
+    reference.setAmplitude(0, Complex(0, 0));
+    reference.setAmplitude(1, Complex(1, 0));
+    QuantumState resumed = reference;
+    wide.apply(reference);
+    wide.apply(resumed, cache, 2);
+    std::cout << "4-qubit exponent skipped " << wide.getGatesSkipped() << " gates (expected 6)" << std::endl;
+    assert(wide.getGatesSkipped() == 6 && "Wider job should resume after the narrower job's gates");
+    assert(sameState(resumed, reference) && "Padded snapshot must give the uncached result");
+    std::cout << "✓ Narrower snapshot reused by a wider job" << std::endl;
+
+    // Fewer exponent qubits: the wide snapshots are truncated
+    Circuit smallest = buildInterleavedModExp(2);
+    QuantumState expected(6);
+    expected.setAmplitude(0, Complex(0, 0));
+    expected.setAmplitude(1, Complex(1, 0));
+    QuantumState truncated = expected;
+    smallest.apply(expected);
+    smallest.apply(truncated, cache);
+    assert(smallest.getGatesSkipped() == 4 && "Whole circuit should come from the cache");
+    assert(sameState(truncated, expected) && "Truncated snapshot must give the uncached result");
+    std::cout << "✓ Wider snapshot reused by a narrower job" << std::endl;
+
+    // A snapshot with amplitudes beyond the narrower state does not fit
+    QuantumState spread(3);
+    HadamardGate(2).apply(spread);
+    cache.insert(42, spread);
+    QuantumState small(2);
+    assert(!cache.lookup(42, small) && small.getAmplitude(0) == Complex(1, 0));
+    std::cout << "✓ Snapshot with nonzero amplitudes beyond the state is a miss" << std::endl;
+}
+
+// Test 4: Only the end of the cacheable part is stored by default
+void test_default_checkpoints() {
+    printTestHeader("Default Checkpoint Test");
+
+    StatePrefixCache cache(1 << 20);
+    Circuit full = buildModExp(4);
+    QuantumState state(8);
+    full.apply(state, cache);
+    assert(cache.getEntryCount() == 1 && "Default run should store one snapshot");
+
+    QuantumState again(8);
+    full.apply(again, cache);
+    assert(full.getGatesSkipped() == 8 && sameState(again, state));
+    std::cout << "✓ One snapshot per run, and a rerun skips all " << full.getGatesSkipped() << " gates" << std::endl;
+
+    bool threw = false;
+    try {
+        full.apply(again, cache, -1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Negative checkpoint interval must be rejected");
+    std::cout << "✓ Negative checkpoint interval rejected" << std::endl;
+}
+
+// Test 5: A key matches only if its check hash matches too, in memory and on disk
+void test_key_check() {
+    printTestHeader("Key Check Test");
+
+    QuantumState stored(3);
+    HadamardGate(0).apply(stored);
+    StatePrefixCache cache(1 << 20);
+    cache.insert(PrefixKey(7, 1), stored);
+    QuantumState restored(3);
+    assert(!cache.contains(PrefixKey(7, 2)) && !cache.lookup(PrefixKey(7, 2), restored));
+    assert(restored.getAmplitude(0) == Complex(1, 0) && "A miss must leave the state untouched");
+    assert(cache.lookup(PrefixKey(7, 1), restored) && sameState(restored, stored));
+    std::cout << "✓ Same hash with another check value is a miss" << std::endl;
+
+    // The hashes differ for prefixes that differ in a single byte
+    PrefixKey base = fingerprintState(stored);
+    PrefixKey first = base.extend("H(1);", 5);
+    PrefixKey second = base.extend("H(2);", 5);
+    assert(first.hash != second.hash && first.check != second.check);
+    assert(first.check != first.hash && "The check hash is independent of FNV-1a");
+
+    std::string directory = (std::filesystem::temp_directory_path() /
+                             ("qstate-test-" + std::to_string(getpid()))).string();
+    {
+        StatePrefixCache writer(1 << 20, directory);
+        writer.insert(PrefixKey(7, 1), stored);
+        writer.persist();
+    }
+    StatePrefixCache reader(1 << 20, directory);
+    QuantumState loaded(3);
+    assert(!reader.contains(PrefixKey(7, 2)) && !reader.lookup(PrefixKey(7, 2), loaded));
+    assert(reader.contains(PrefixKey(7, 1)) && reader.lookup(PrefixKey(7, 1), loaded));
+    assert(sameState(loaded, stored));
+    std::cout << "✓ Spilled snapshot is found only under its full key" << std::endl;
+
+    // A file without the header (the old format) is a miss
+    {
+        std::ofstream file(directory + "/0000000000000007.qstate", std::ios::binary | std::ios::trunc);
+        int num_qubits = stored.getNumQubits();
+        file.write(reinterpret_cast<const char*>(&num_qubits), sizeof(num_qubits));
+        file.write(reinterpret_cast<const char*>(stored.data()),
+                   static_cast<std::streamsize>(stored.getStateSize() * sizeof(Complex)));
+    }
+    StatePrefixCache stale(1 << 20, directory);
+    QuantumState untouched(3);
+    assert(!stale.contains(PrefixKey(7, 1)) && !stale.lookup(PrefixKey(7, 1), untouched));
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ File without a valid header is a miss" << std::endl;
+}
+
+// Test 6: Integer parameters beyond double precision stay distinct
+void test_exact_descriptions() {
+    printTestHeader("Exact Description Test");
+
+    uint64_t large = (uint64_t(1) << 53) + 1;  // Rounds to 2^53 as a double
+    uint64_t modulus = (uint64_t(1) << 61) - 1;
+    std::string exact = ControlledModMultGate(0, 1, 61, large, modulus).describe();
+    std::string rounded = ControlledModMultGate(0, 1, 61, large - 1, modulus).describe();
+    std::cout << exact << " vs " << rounded << std::endl;
+    assert(exact == "CMODMULT(0,1,61,9007199254740993,2305843009213693951)");
+    assert(exact != rounded && "Multipliers one apart must be described differently");
+    assert(describeGate("T", {large}) != describeGate("T", {large - 1}));
+    assert(describeGate("PHASE", {3, 0.1}) == "PHASE(3,0.10000000000000001)");
+    std::cout << "✓ Integers print exactly, reals at full precision" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   State Prefix Cache Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_resume_from_prefix();
+        test_lru_budget();
+        test_cross_width();
+        test_default_checkpoints();
+        test_key_check();
+        test_exact_descriptions();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All tests passed successfully! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,166 @@
+#include "uniform_state.h"
+#include "quantum_arithmetic.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+// Helper function to print test header
+void printTestHeader(const std::string& test_name) {
+    std::cout << "\n=== " << test_name << " ===" << std::endl;
+}
+
+// Apply the same gate to the dense reference and the uniform state
+void applyBoth(QuantumGate&& gate, QuantumState& dense, UniformSupportState& uniform) {
+    gate.apply(dense);
+    uniform.apply(gate);
+}
+
+double maxDifference(const QuantumState& dense, const UniformSupportState& uniform) {
+    QuantumState expanded = uniform.toDense();
+    double difference = 0.0;
+    for (int i = 0; i < dense.getStateSize(); i++) {
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - expanded.getAmplitude(i)));
+        difference = std::max(difference, std::abs(dense.getAmplitude(i) - uniform.getAmplitude(i)));
+    }
+    return difference;
+}
+
+void test_modular_exponentiation() {
+    printTestHeader("Modular Exponentiation on the Support Set");
+
+    // 7^x mod 15, 4-qubit exponent, as in main
+    const int n = 4;
+    const int m = 4;
+    const uint64_t modulus = 15;
+    QuantumState dense(n + m);
+    UniformSupportState uniform(n + m);
+    applyBoth(XGate(n), dense, uniform);
+    for (int q = 0; q < n; q++) {
+        applyBoth(HadamardGate(q), dense, uniform);
+    }
+    assert(uniform.isUniform() && uniform.getSupportSize() == (1u << n));
+    assert(!uniform.hasPhases() && "Hadamards on |0⟩ qubits need no phase table");
+
+    uint64_t multiplier = 7;
+    for (int q = 0; q < n; q++) {
+        applyBoth(ControlledModMultGate(q, n, m, multiplier, modulus), dense, uniform);
+        multiplier = (multiplier * multiplier) % modulus;
+    }
+    assert(uniform.isUniform() && "Permutations must keep the state uniform");
+    assert(uniform.getSupportSize() == (1u << n));
+    double difference = maxDifference(dense, uniform);
+    std::cout << "Max difference to dense: " << difference << std::endl;
+    assert(difference < 1e-12 && "Uniform state must match the dense state");
+    std::cout << "✓ " << uniform.getSupportSize() << " indices (" << uniform.getMemoryUsage()
+              << " bytes) instead of " << dense.getMemoryUsage() << " bytes" << std::endl;
+
+    // Windowed multiplication and register swaps are index rewrites as well
+    std::vector<uint64_t> table = {1, 2, 4, 8};
+    applyBoth(LookupModMultGate(0, 2, n, m, table, modulus), dense, uniform);
+    applyBoth(ControlledRegisterSwapGate(7, 0, 2, 2), dense, uniform);
+    applyBoth(RegisterSwapGate(0, 4, 2), dense, uniform);
+    applyBoth(ToffoliGate(0, 1, 6), dense, uniform);
+    applyBoth(SWAPGate(2, 5), dense, uniform);
+    applyBoth(CNOTGate(3, 0), dense, uniform);
+    assert(uniform.isUniform());
+    assert(maxDifference(dense, uniform) < 1e-12);
+    std::cout << "✓ Lookup multiplication, register swaps, Toffoli, SWAP and CNOT rewrite indices" << std::endl;
+}
+
+void test_phases_and_hadamards() {
+    printTestHeader("Phases and Interfering Hadamards");
+
+    const int n = 5;
+    QuantumState dense(n);
+    UniformSupportState uniform(n);
+    applyBoth(XGate(1), dense, uniform);
+    for (int q = 0; q < 3; q++) {
+        applyBoth(HadamardGate(q), dense, uniform);  // Qubit 1 is |1⟩: a -1 phase appears
+    }
+    applyBoth(PhaseShiftGate(2, M_PI / 4), dense, uniform);
+    applyBoth(ControlledPhaseShiftGate(std::vector<int>{0, 2}, 1, 0.3), dense, uniform);
+    applyBoth(CNOTGate(0, 4), dense, uniform);
+    assert(uniform.hasPhases() && uniform.getSupportSize() == 8);
+    assert(maxDifference(dense, uniform) < 1e-12);
+    std::cout << "✓ Phase table tracks PhaseShift and controlled phases" << std::endl;
+
+    // Undo the phases, then H on qubit 1 makes every pair interfere fully
+    applyBoth(ControlledPhaseShiftGate(std::vector<int>{0, 2}, 1, -0.3), dense, uniform);
+    applyBoth(PhaseShiftGate(2, -M_PI / 4), dense, uniform);
+    applyBoth(HadamardGate(1), dense, uniform);
+    assert(uniform.isUniform() && uniform.getSupportSize() == 4 && "Interfering Hadamard halves the support");
+    assert(!uniform.hasPhases());
+    assert(maxDifference(dense, uniform) < 1e-12);
+    std::cout << "✓ Fully interfering Hadamard halves the support" << std::endl;
+
+    // Composite gates are expanded: a QFT quickly leaves the uniform form
+    applyBoth(PhaseShiftGate(0, 0.4), dense, uniform);
+    applyBoth(QFTGate(0, 3), dense, uniform);
+    assert(!uniform.isUniform() && "Partial interference must convert to dense");
+    applyBoth(XGate(3), dense, uniform);
+    assert(maxDifference(dense, uniform) < 1e-12);
+    std::cout << "✓ Mixing gate converts to dense and later gates follow" << std::endl;
+}
+
+// Multiplying by 2 mod 4 maps y = 1 and y = 3 to the same value
+void test_non_coprime_multiplier() {
+    printTestHeader("Non-Invertible Multiplier");
+
+    QuantumState dense(3);
+    UniformSupportState uniform(3);
+    applyBoth(HadamardGate(0), dense, uniform);
+    applyBoth(XGate(1), dense, uniform);
+    applyBoth(HadamardGate(2), dense, uniform);  // Target holds y = 1 and y = 3
+    applyBoth(ControlledModMultGate(0, 1, 2, 2, 4), dense, uniform);
+    assert(!uniform.isUniform() && "Merging multiplication must convert to dense");
+    assert(maxDifference(dense, uniform) < 1e-12);
+    std::cout << "✓ Controlled 2·y mod 4 converted to dense instead of duplicating indices" << std::endl;
+
+    QuantumState lookup_dense(3);
+    UniformSupportState lookup_uniform(3);
+    applyBoth(HadamardGate(0), lookup_dense, lookup_uniform);
+    applyBoth(XGate(1), lookup_dense, lookup_uniform);
+    applyBoth(HadamardGate(2), lookup_dense, lookup_uniform);
+    applyBoth(LookupModMultGate(0, 1, 1, 2, {1, 2}, 4), lookup_dense, lookup_uniform);
+    assert(!lookup_uniform.isUniform());
+    assert(maxDifference(lookup_dense, lookup_uniform) < 1e-12);
+    std::cout << "✓ Lookup table with 2 mod 4 converted to dense as well" << std::endl;
+}
+
+void test_invalid_gates() {
+    printTestHeader("Invalid Gates");
+
+    UniformSupportState uniform(3);
+    bool threw = false;
+    try {
+        XGate gate(3);
+        uniform.apply(gate);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && "Gate beyond the state must be rejected");
+    std::cout << "✓ Gate beyond the state rejected" << std::endl;
+}
+
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "   Uniform-Support State Test Suite" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    try {
+        test_modular_exponentiation();
+        test_phases_and_hadamards();
+        test_non_coprime_multiplier();
+        test_invalid_gates();
+
+        std::cout << "\n========================================" << std::endl;
+        std::cout << "   All uniform-support state tests passed! ✓" << std::endl;
+        std::cout << "========================================" << std::endl;
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,409 @@
+#ifndef UNIFORM_STATE_H
+#define UNIFORM_STATE_H
+
+#include "quantum_state.h"
+#include "quantum_gates.h"
+#include "complex_math.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Uniform-Support State: equal-magnitude superposition over an index set
+// Stores a sorted list of the basis states with nonzero amplitude, one
+// amplitude shared by all of them and, once a phase gate has acted, one
+// relative phase per index:
+//     |ψ⟩ = amplitude · Σ_k phase_k |support_k⟩
+// Permutation gates (X, CNOT, SWAP, Toffoli, modular multiplications,
+// register swaps) only rewrite the indices, and phase gates only touch the
+// phase table, so a modular exponentiation after the Hadamard layer costs
+// 2^n index updates instead of 2^(n+m) amplitude moves. Hadamards keep the
+// state uniform when they double the support (the qubit is the same in
+// every index) or halve it (every pair interferes fully). Any other mixing
+// gate, and a modular multiplication whose multiplier is not coprime to the
+// modulus (it would merge indices), converts the state to a dense
+// QuantumState, which then receives all further gates.
+class UniformSupportState {
+private:
+    int num_qubits;
+    std::vector<int> support;     // Sorted basis indices with nonzero amplitude
+    std::vector<Complex> phases;  // Relative phase per support index; empty = all 1
+    Complex amplitude;            // Amplitude shared by every support index
+    std::unique_ptr<QuantumState> dense;  // Non-null once a mixing gate was applied
+
+    // Rewrite every support index through a basis permutation, then
+    // restore the sort order (phases travel with their indices)
+    template <typename Map>
+    void permute(Map map) {
+        for (int& index : support) {
+            index = map(index);
+        }
+        if (std::is_sorted(support.begin(), support.end())) {
+            return;
+        }
+        if (phases.empty()) {
+            std::sort(support.begin(), support.end());
+            return;
+        }
+        std::vector<std::pair<int, Complex>> entries(support.size());
+        for (size_t k = 0; k < support.size(); k++) {
+            entries[k] = std::make_pair(support[k], phases[k]);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const std::pair<int, Complex>& lhs, const std::pair<int, Complex>& rhs) {
+                      return lhs.first < rhs.first;
+                  });
+        for (size_t k = 0; k < support.size(); k++) {
+            support[k] = entries[k].first;
+            phases[k] = entries[k].second;
+        }
+    }
+
+    // Multiply the phase of every index whose bits cover 'mask'
+    void applyPhase(int mask, double angle) {
+        if (phases.empty()) {
+            phases.assign(support.size(), Complex(1, 0));
+        }
+        Complex factor(std::cos(angle), std::sin(angle));
+        for (size_t k = 0; k < support.size(); k++) {
+            if ((support[k] & mask) == mask) {
+                phases[k] = complexMul(phases[k], factor);
+            }
+        }
+    }
+
+    Complex phaseAt(size_t k) const {
+        return phases.empty() ? Complex(1, 0) : phases[k];
+    }
+
+    // Hadamard on qubit 'target' if the result is still uniform
+    // Returns false (state unchanged) when the state would stop being uniform
+    bool applyHadamard(int target) {
+        int bit = 1 << target;
+        size_t set_count = 0;
+        for (int index : support) {
+            if (index & bit) {
+                set_count++;
+            }
+        }
+
+        // Qubit has the same value b in every index: the support doubles,
+        // |..b..⟩ → (|..0..⟩ + (-1)^b |..1..⟩)/√2
+        if (set_count == 0 || set_count == support.size()) {
+            bool was_set = (set_count != 0);
+            std::vector<int> low(support.size());
+            for (size_t k = 0; k < support.size(); k++) {
+                low[k] = support[k] & ~bit;
+            }
+            bool with_phases = was_set || !phases.empty();
+            std::vector<int> expanded;
+            std::vector<Complex> expanded_phases;
+            expanded.reserve(2 * support.size());
+            expanded_phases.reserve(with_phases ? 2 * support.size() : 0);
+            // Both halves are sorted; interleave them in order
+            size_t a = 0;
+            size_t b = 0;
+            while (a < low.size() || b < low.size()) {
+                bool take_low = b == low.size() || (a < low.size() && low[a] < (low[b] | bit));
+                if (take_low) {
+                    expanded.push_back(low[a]);
+                    if (with_phases) {
+                        expanded_phases.push_back(phaseAt(a));
+                    }
+                    a++;
+                } else {
+                    expanded.push_back(low[b] | bit);
+                    if (with_phases) {
+                        expanded_phases.push_back(was_set ? -phaseAt(b) : phaseAt(b));
+                    }
+                    b++;
+                }
+            }
+            support.swap(expanded);
+            phases.swap(expanded_phases);
+            amplitude /= std::sqrt(2.0);
+            return true;
+        }
+
+        // Every index must have its partner, and each pair must interfere
+        // completely (equal or opposite phases) so one of the two survives
+        if (2 * set_count != support.size()) {
+            return false;
+        }
+        std::vector<int> contracted;
+        std::vector<Complex> contracted_phases;
+        contracted.reserve(set_count);
+        for (size_t k = 0; k < support.size(); k++) {
+            if (support[k] & bit) {
+                continue;
+            }
+            int partner = support[k] | bit;
+            auto it = std::lower_bound(support.begin(), support.end(), partner);
+            if (it == support.end() || *it != partner) {
+                return false;
+            }
+            Complex p0 = phaseAt(k);
+            Complex p1 = phaseAt(size_t(it - support.begin()));
+            Complex sum = 0.5 * (p0 + p1);
+            Complex difference = 0.5 * (p0 - p1);
+            if (std::abs(std::abs(sum) - 1.0) < 1e-12) {
+                contracted.push_back(support[k]);
+                contracted_phases.push_back(sum);
+            } else if (std::abs(std::abs(difference) - 1.0) < 1e-12) {
+                contracted.push_back(partner);
+                contracted_phases.push_back(difference);
+            } else {
+                return false;
+            }
+        }
+        std::vector<size_t> order(contracted.size());
+        for (size_t k = 0; k < order.size(); k++) {
+            order[k] = k;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            return contracted[lhs] < contracted[rhs];
+        });
+        support.resize(contracted.size());
+        phases.resize(contracted.size());
+        bool all_one = true;
+        for (size_t k = 0; k < order.size(); k++) {
+            support[k] = contracted[order[k]];
+            phases[k] = contracted_phases[order[k]];
+            all_one = all_one && std::abs(phases[k] - Complex(1, 0)) < 1e-12;
+        }
+        if (all_one) {
+            phases.clear();
+        }
+        amplitude *= std::sqrt(2.0);
+        return true;
+    }
+
+    // Index map of a known permutation gate; false for any other gate and
+    // for modular multiplications that are not permutations (see
+    // isModMultPermutation), which then run on the dense state
+    bool applyPermutation(const QuantumGate& gate) {
+        if (auto g = dynamic_cast<const XGate*>(&gate)) {
+            requireQubits({g->getTarget()});
+            int bit = 1 << g->getTarget();
+            permute([=](int i) { return i ^ bit; });
+            return true;
+        }
+        if (auto g = dynamic_cast<const CNOTGate*>(&gate)) {
+            int control = g->getControl();
+            int target = g->getTarget();
+            requireQubits({control, target});
+            permute([=](int i) { return i ^ (((i >> control) & 1) << target); });
+            return true;
+        }
+        if (auto g = dynamic_cast<const SWAPGate*>(&gate)) {
+            int q1 = g->getQubit1();
+            int q2 = g->getQubit2();
+            requireQubits({q1, q2});
+            permute([=](int i) {
+                int d = ((i >> q1) ^ (i >> q2)) & 1;
+                return i ^ ((d << q1) | (d << q2));
+            });
+            return true;
+        }
+        if (auto g = dynamic_cast<const ToffoliGate*>(&gate)) {
+            int c1 = g->getControl1();
+            int c2 = g->getControl2();
+            int target = g->getTarget();
+            requireQubits({c1, c2, target});
+            permute([=](int i) { return i ^ (((i >> c1) & (i >> c2) & 1) << target); });
+            return true;
+        }
+        if (auto g = dynamic_cast<const ControlledModMultGate*>(&gate)) {
+            requireQubits({g->getControl(), g->getTargetStart() + g->getTargetCount() - 1});
+            int control_mask = 1 << g->getControl();
+            int start = g->getTargetStart();
+            uint64_t field = (1ULL << g->getTargetCount()) - 1;
+            uint64_t multiplier = g->getMultiplier();
+            uint64_t modulus = g->getModulus();
+            if (!isModMultPermutation(multiplier, modulus, g->getTargetCount())) {
+                return false;  // Merges support indices: not a rewrite
+            }
+            permute([=](int i) {
+                uint64_t y = (uint64_t(i) >> start) & field;
+                if ((i & control_mask) == 0 || y >= modulus) {
+                    return i;
+                }
+                return (i & ~int(field << start)) | int(((multiplier * y) % modulus) << start);
+            });
+            return true;
+        }
+        if (auto g = dynamic_cast<const LookupModMultGate*>(&gate)) {
+            requireQubits({g->getWindowStart() + g->getWindowSize() - 1,
+                           g->getTargetStart() + g->getTargetCount() - 1});
+            int window_start = g->getWindowStart();
+            int window_mask = (1 << g->getWindowSize()) - 1;
+            int start = g->getTargetStart();
+            uint64_t field = (1ULL << g->getTargetCount()) - 1;
+            const std::vector<uint64_t>& multipliers = g->getMultipliers();
+            uint64_t modulus = g->getModulus();
+            for (uint64_t multiplier : multipliers) {
+                if (!isModMultPermutation(multiplier, modulus, g->getTargetCount())) {
+                    return false;
+                }
+            }
+            permute([&](int i) {
+                uint64_t y = (uint64_t(i) >> start) & field;
+                if (y >= modulus) {
+                    return i;
+                }
+                uint64_t multiplier = multipliers[(i >> window_start) & window_mask];
+                return (i & ~int(field << start)) | int(((multiplier * y) % modulus) << start);
+            });
+            return true;
+        }
+        if (auto g = dynamic_cast<const RegisterSwapGate*>(&gate)) {
+            requireQubits({g->getAStart() + g->getCount() - 1, g->getBStart() + g->getCount() - 1});
+            swapFields(0, g->getAStart(), g->getBStart(), g->getCount());
+            return true;
+        }
+        if (auto g = dynamic_cast<const ControlledRegisterSwapGate*>(&gate)) {
+            requireQubits({g->getControl(), g->getAStart() + g->getCount() - 1,
+                           g->getBStart() + g->getCount() - 1});
+            swapFields(1 << g->getControl(), g->getAStart(), g->getBStart(), g->getCount());
+            return true;
+        }
+        return false;
+    }
+
+    void swapFields(int control_mask, int a_start, int b_start, int count) {
+        int field = (1 << count) - 1;
+        permute([=](int i) {
+            if ((i & control_mask) != control_mask) {
+                return i;
+            }
+            int a = (i >> a_start) & field;
+            int b = (i >> b_start) & field;
+            int cleared = i & ~((field << a_start) | (field << b_start));
+            return cleared | (b << a_start) | (a << b_start);
+        });
+    }
+
+    // Reject gates that reach beyond the state
+    void requireQubits(std::initializer_list<int> qubits) const {
+        for (int q : qubits) {
+            if (q >= num_qubits) {
+                throw std::invalid_argument("Gate qubit exceeds number of qubits in state");
+            }
+        }
+    }
+
+    void densify() {
+        dense.reset(new QuantumState(toDense()));
+        support.clear();
+        support.shrink_to_fit();
+        phases.clear();
+        phases.shrink_to_fit();
+    }
+
+public:
+    // Constructor: n qubits in |00...0⟩ (a support of one index)
+    UniformSupportState(int n) : num_qubits(n), support(1, 0), amplitude(1, 0) {
+        if (n <= 0 || n > 30) {
+            throw std::invalid_argument("Number of qubits must be between 1 and 30");
+        }
+    }
+
+    // Apply a gate, keeping the uniform form whenever possible
+    // Composite gates are expanded through decompose(), so e.g. an adder
+    // made of Toffoli/CNOT/X gates stays a pure index rewrite
+    void apply(QuantumGate& gate) {
+        if (dense) {
+            gate.apply(*dense);
+            return;
+        }
+        if (applyPermutation(gate)) {
+            return;
+        }
+        if (auto g = dynamic_cast<const PhaseShiftGate*>(&gate)) {
+            requireQubits({g->getTarget()});
+            applyPhase(1 << g->getTarget(), g->getPhase());
+            return;
+        }
+        if (auto g = dynamic_cast<const ControlledPhaseShiftGate*>(&gate)) {
+            int mask = 1 << g->getTarget();
+            requireQubits({g->getTarget()});
+            for (int control : g->getControls()) {
+                requireQubits({control});
+                mask |= 1 << control;
+            }
+            applyPhase(mask, g->getPhase());
+            return;
+        }
+        if (auto g = dynamic_cast<const HadamardGate*>(&gate)) {
+            requireQubits({g->getTarget()});
+            if (applyHadamard(g->getTarget())) {
+                return;
+            }
+        } else {
+            std::vector<std::shared_ptr<QuantumGate>> parts = gate.decompose();
+            if (!parts.empty()) {
+                for (const auto& part : parts) {
+                    apply(*part);
+                }
+                return;
+            }
+        }
+
+        // Mixing gate: continue on a dense state vector
+        densify();
+        gate.apply(*dense);
+    }
+
+    // True while the state is still held as a uniform support set
+    bool isUniform() const { return !dense; }
+
+    int getNumQubits() const { return num_qubits; }
+    const std::vector<int>& getSupport() const { return support; }
+    size_t getSupportSize() const { return support.size(); }
+    bool hasPhases() const { return !phases.empty(); }
+    Complex getSharedAmplitude() const { return amplitude; }
+
+    Complex getAmplitude(int index) const {
+        if (index < 0 || index >= (1 << num_qubits)) {
+            throw std::out_of_range("Index out of range");
+        }
+        if (dense) {
+            return dense->getAmplitude(index);
+        }
+        auto it = std::lower_bound(support.begin(), support.end(), index);
+        if (it == support.end() || *it != index) {
+            return Complex(0, 0);
+        }
+        return complexMul(amplitude, phaseAt(size_t(it - support.begin())));
+    }
+
+    double getProbability(int index) const {
+        return std::norm(getAmplitude(index));
+    }
+
+    // Full state vector
+    QuantumState toDense() const {
+        if (dense) {
+            return *dense;
+        }
+        QuantumState state(num_qubits);
+        Complex* amplitudes = state.data();
+        amplitudes[0] = Complex(0, 0);
+        for (size_t k = 0; k < support.size(); k++) {
+            amplitudes[support[k]] = complexMul(amplitude, phaseAt(k));
+        }
+        return state;
+    }
+
+    // Memory used by the index list and phase table (or the dense vector)
+    size_t getMemoryUsage() const {
+        if (dense) {
+            return dense->getMemoryUsage();
+        }
+        return support.capacity() * sizeof(int) + phases.capacity() * sizeof(Complex);
+    }
+};
+
+#endif // UNIFORM_STATE_H